@@ -0,0 +1,55 @@
+#include <memory>
+#include <mutex>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/concurrent_vector.hpp"
+#include "containers/vector.hpp"
+
+// Threads appending to one shared vector: a steev::vector behind a mutex
+// against concurrent_vector. Runs with 1 to 8 threads and a fixed number of
+// appends per thread so the vectors stay a sensible size.
+
+namespace
+{
+constexpr int appends = 1 << 18;
+
+std::mutex locked_mutex;
+std::unique_ptr<steev::vector<long>> locked;
+std::unique_ptr<steev::concurrent_vector<long>> concurrent;
+}  // namespace
+
+void BM_AppendLocked(benchmark::State& state)
+{
+  if (state.thread_index() == 0) {
+    locked = std::make_unique<steev::vector<long>>();
+  }
+  for (auto _ : state) {
+    std::lock_guard lock(locked_mutex);
+    locked->push_back(state.thread_index());
+  }
+  if (state.thread_index() == 0) {
+    locked.reset();
+  }
+}
+BENCHMARK(BM_AppendLocked)
+    ->ThreadRange(1, 8)
+    ->Iterations(appends)
+    ->UseRealTime();
+
+void BM_AppendConcurrent(benchmark::State& state)
+{
+  if (state.thread_index() == 0) {
+    concurrent = std::make_unique<steev::concurrent_vector<long>>();
+  }
+  for (auto _ : state) {
+    concurrent->push_back(state.thread_index());
+  }
+  if (state.thread_index() == 0) {
+    concurrent.reset();
+  }
+}
+BENCHMARK(BM_AppendConcurrent)
+    ->ThreadRange(1, 8)
+    ->Iterations(appends)
+    ->UseRealTime();
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/flat_hash_map.hpp"
+
+// Looks up random present and absent keys in tables too big for the cache
+// at the larger sizes, and fills a table from empty. Each runs against
+// std::unordered_map and steev::flat_hash_map.
+
+namespace
+{
+std::vector<std::uint64_t> random_keys(std::size_t count, unsigned seed)
+{
+  std::mt19937_64 engine(seed);
+  std::vector<std::uint64_t> keys(count);
+  for (auto& key : keys) {
+    key = engine();
+  }
+  return keys;
+}
+}  // namespace
+
+template<typename Map>
+void BM_MapFindHit(benchmark::State& state)
+{
+  auto keys = random_keys(static_cast<std::size_t>(state.range(0)), 1);
+  Map map;
+  for (std::uint64_t key : keys) {
+    map[key] = key;
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937_64(2));
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.find(keys[i])->second);
+    i = i + 1 == keys.size() ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MapFindHit<std::unordered_map<std::uint64_t, std::uint64_t>>)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_MapFindHit<steev::flat_hash_map<std::uint64_t, std::uint64_t>>)
+    ->Range(1 << 10, 1 << 20);
+
+template<typename Map>
+void BM_MapFindMiss(benchmark::State& state)
+{
+  auto keys = random_keys(static_cast<std::size_t>(state.range(0)), 1);
+  auto misses = random_keys(keys.size(), 3);
+  Map map;
+  for (std::uint64_t key : keys) {
+    map[key] = key;
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.find(misses[i]) == map.end());
+    i = i + 1 == misses.size() ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MapFindMiss<std::unordered_map<std::uint64_t, std::uint64_t>>)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_MapFindMiss<steev::flat_hash_map<std::uint64_t, std::uint64_t>>)
+    ->Range(1 << 10, 1 << 20);
+
+template<typename Map>
+void BM_MapInsert(benchmark::State& state)
+{
+  auto keys = random_keys(static_cast<std::size_t>(state.range(0)), 1);
+  for (auto _ : state) {
+    Map map;
+    for (std::uint64_t key : keys) {
+      map[key] = key;
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MapInsert<std::unordered_map<std::uint64_t, std::uint64_t>>)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_MapInsert<steev::flat_hash_map<std::uint64_t, std::uint64_t>>)
+    ->Range(1 << 10, 1 << 20);
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/flat_map.hpp"
+
+// Looks up random keys in maps from cache-sized up to far bigger than the
+// cache: std::map, std::lower_bound over a sorted std::vector, and
+// steev::flat_map with each search layout. Building from unsorted pairs is
+// timed against inserting them one at a time into std::map.
+
+namespace
+{
+std::vector<std::uint32_t> random_keys(std::size_t count, unsigned seed)
+{
+  std::mt19937 engine(seed);
+  std::vector<std::uint32_t> keys(count);
+  for (auto& key : keys) {
+    key = static_cast<std::uint32_t>(engine());
+  }
+  return keys;
+}
+
+steev::vector<std::uint32_t> to_steev(const std::vector<std::uint32_t>& keys)
+{
+  steev::vector<std::uint32_t> copy;
+  copy.reserve(keys.size());
+  for (std::uint32_t key : keys) {
+    copy.push_back(key);
+  }
+  return copy;
+}
+
+template<typename Layout>
+using flat_map =
+    steev::flat_map<std::uint32_t, std::uint32_t, std::less<>, Layout>;
+
+// Half the probes are present keys and half random ones
+template<typename Lookup>
+void run_lookups(benchmark::State& state, Lookup lookup)
+{
+  auto keys = random_keys(static_cast<std::size_t>(state.range(0)), 1);
+  auto probes = random_keys(keys.size(), 2);
+  std::copy_n(keys.begin(), keys.size() / 2, probes.begin());
+  std::shuffle(probes.begin(), probes.end(), std::mt19937(3));
+  auto find = lookup(keys);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(find(probes[i]));
+    i = i + 1 == probes.size() ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+}  // namespace
+
+void BM_StdMapFind(benchmark::State& state)
+{
+  run_lookups(state,
+              [](const std::vector<std::uint32_t>& keys)
+              {
+                auto map = std::make_shared<std::map<std::uint32_t,
+                                                     std::uint32_t>>();
+                for (std::uint32_t key : keys) {
+                  (*map)[key] = key;
+                }
+                return [map](std::uint32_t key) { return map->contains(key); };
+              });
+}
+BENCHMARK(BM_StdMapFind)->Range(1 << 10, 1 << 22);
+
+void BM_SortedVectorFind(benchmark::State& state)
+{
+  run_lookups(
+      state,
+      [](std::vector<std::uint32_t> keys)
+      {
+        std::sort(keys.begin(), keys.end());
+        return [keys = std::move(keys)](std::uint32_t key)
+        {
+          auto it = std::lower_bound(keys.begin(), keys.end(), key);
+          return it != keys.end() && *it == key;
+        };
+      });
+}
+BENCHMARK(BM_SortedVectorFind)->Range(1 << 10, 1 << 22);
+
+template<typename Layout>
+void BM_FlatMapFind(benchmark::State& state)
+{
+  run_lookups(state,
+              [](const std::vector<std::uint32_t>& keys)
+              {
+                auto map = std::make_shared<flat_map<Layout>>(to_steev(keys),
+                                                              to_steev(keys));
+                return [map](std::uint32_t key) { return map->contains(key); };
+              });
+}
+BENCHMARK(BM_FlatMapFind<steev::sorted_layout>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_FlatMapFind<steev::eytzinger_layout>)->Range(1 << 10, 1 << 22);
+
+void BM_StdMapBuild(benchmark::State& state)
+{
+  auto keys = random_keys(static_cast<std::size_t>(state.range(0)), 1);
+  for (auto _ : state) {
+    std::map<std::uint32_t, std::uint32_t> map;
+    for (std::uint32_t key : keys) {
+      map.try_emplace(key, key);
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdMapBuild)->Range(1 << 10, 1 << 20);
+
+template<typename Layout>
+void BM_FlatMapBuild(benchmark::State& state)
+{
+  auto keys = random_keys(static_cast<std::size_t>(state.range(0)), 1);
+  for (auto _ : state) {
+    flat_map<Layout> map(to_steev(keys), to_steev(keys));
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FlatMapBuild<steev::sorted_layout>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_FlatMapBuild<steev::eytzinger_layout>)->Range(1 << 10, 1 << 20);
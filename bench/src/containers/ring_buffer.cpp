@@ -0,0 +1,39 @@
+#include <cstddef>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/ring_buffer.hpp"
+
+// Pushes and pops on one thread, element by element and in batches of
+// state.range(0), to show what one index update per batch saves
+
+template<typename Ring>
+void BM_RingSingle(benchmark::State& state)
+{
+  Ring ring;
+  int value = 0;
+  for (auto _ : state) {
+    ring.try_push(value);
+    ring.try_pop(value);
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RingSingle<steev::spsc_ring<int, 1024>>);
+BENCHMARK(BM_RingSingle<steev::mpmc_ring<int, 1024>>);
+
+template<typename Ring>
+void BM_RingBatch(benchmark::State& state)
+{
+  Ring ring;
+  auto batch = static_cast<std::size_t>(state.range(0));
+  int values[64] {};
+  for (auto _ : state) {
+    ring.push_batch(values, batch);
+    ring.pop_batch(values, batch);
+    benchmark::DoNotOptimize(values);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RingBatch<steev::spsc_ring<int, 1024>>)->Range(4, 64);
+BENCHMARK(BM_RingBatch<steev::mpmc_ring<int, 1024>>)->Range(4, 64);
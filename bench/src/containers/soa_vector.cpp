@@ -0,0 +1,61 @@
+#include <cstddef>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/soa_vector.hpp"
+#include "containers/vector.hpp"
+
+// Filters on one field of a 32-byte record, stored as an array of records
+// and as one column per field
+
+namespace
+{
+struct Record
+{
+  std::int64_t id;
+  double price;
+  std::int64_t quantity;
+  std::int64_t flags;
+};
+}  // namespace
+
+void BM_ScanArrayOfStructs(benchmark::State& state)
+{
+  auto count = static_cast<std::size_t>(state.range(0));
+  steev::vector<Record> records;
+  records.reserve(count);
+  for (std::size_t i = 0; i < count; i++) {
+    auto id = static_cast<std::int64_t>(i);
+    records.push_back({id, static_cast<double>(i % 100), id, 0});
+  }
+  for (auto _ : state) {
+    std::size_t matches = 0;
+    for (const Record& record : records) {
+      matches += record.price > 50.0 ? 1U : 0U;
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScanArrayOfStructs)->Range(1 << 10, 1 << 22);
+
+void BM_ScanStructOfArrays(benchmark::State& state)
+{
+  auto count = static_cast<std::size_t>(state.range(0));
+  steev::soa_vector<std::int64_t, double, std::int64_t, std::int64_t> records;
+  records.reserve(count);
+  for (std::size_t i = 0; i < count; i++) {
+    auto id = static_cast<std::int64_t>(i);
+    records.emplace_back(id, static_cast<double>(i % 100), id, 0);
+  }
+  for (auto _ : state) {
+    std::size_t matches = 0;
+    for (double price : records.column<1>()) {
+      matches += price > 50.0 ? 1U : 0U;
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScanStructOfArrays)->Range(1 << 10, 1 << 22);
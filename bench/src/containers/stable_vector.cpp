@@ -0,0 +1,36 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/stable_vector.hpp"
+#include "containers/vector.hpp"
+
+// Appends heap-allocated strings one at a time. The counter is the slowest
+// single append, which for steev::vector is the last doubling moving every
+// string and for stable_vector is at most a chunk allocation.
+
+template<typename Vector>
+void BM_Append(benchmark::State& state)
+{
+  auto count = static_cast<std::size_t>(state.range(0));
+  double slowest = 0;
+  for (auto _ : state) {
+    Vector strings;
+    for (std::size_t i = 0; i < count; i++) {
+      auto start = std::chrono::steady_clock::now();
+      strings.push_back(std::string(32, 'x'));
+      std::chrono::duration<double, std::micro> took =
+          std::chrono::steady_clock::now() - start;
+      slowest = std::max(slowest, took.count());
+    }
+    benchmark::DoNotOptimize(strings.back());
+  }
+  state.counters["slowest_us"] = slowest;
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Append<steev::vector<std::string>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Append<steev::stable_vector<std::string>>)
+    ->Range(1 << 10, 1 << 20);
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/vector.hpp"
+
+// Each benchmark runs once against std::vector and once against steev::vector
+// so the two show up next to each other in the output
+
+namespace
+{
+// Strings are long enough to live on the heap, so moving one isn't free
+template<typename T>
+T make_element(std::size_t i)
+{
+  if constexpr (std::is_same_v<T, std::string>) {
+    return std::string(32, 'x');
+  } else {
+    return static_cast<T>(i);
+  }
+}
+
+template<typename Vector>
+Vector filled(std::size_t count)
+{
+  using T = typename Vector::value_type;
+  Vector vector;
+  for (std::size_t i = 0; i < count; i++) {
+    vector.push_back(make_element<T>(i));
+  }
+  return vector;
+}
+}  // namespace
+
+// Appends state.range(0) elements to an empty vector, growth included
+template<typename Vector>
+void BM_PushBack(benchmark::State& state)
+{
+  auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    Vector vector = filled<Vector>(count);
+    benchmark::DoNotOptimize(vector.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_PushBack, std::vector<int>)->Range(8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_PushBack, steev::vector<int>)->Range(8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_PushBack, std::vector<std::string>)->Range(8, 1 << 12);
+BENCHMARK_TEMPLATE(BM_PushBack, steev::vector<std::string>)->Range(8, 1 << 12);
+
+// GCC 12 flags a null dereference inside std::vector's reallocating insert
+// on a path that can't be taken
+#if defined(__GNUC__) && !defined(__clang__)
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wnull-dereference"
+#endif
+
+// Inserts at the front, shifting every element each time
+template<typename Vector>
+void BM_InsertFront(benchmark::State& state)
+{
+  auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    Vector vector;
+    for (std::size_t i = 0; i < count; i++) {
+      vector.insert(vector.begin(), static_cast<int>(i));
+    }
+    benchmark::DoNotOptimize(vector.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#  pragma GCC diagnostic pop
+#endif
+BENCHMARK_TEMPLATE(BM_InsertFront, std::vector<int>)->Range(8, 1 << 10);
+BENCHMARK_TEMPLATE(BM_InsertFront, steev::vector<int>)->Range(8, 1 << 10);
+
+// Erases from the front until the vector is empty
+template<typename Vector>
+void BM_EraseFront(benchmark::State& state)
+{
+  auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector vector = filled<Vector>(count);
+    state.ResumeTiming();
+    while (vector.size() != 0) {
+      vector.erase(vector.begin());
+    }
+    benchmark::DoNotOptimize(vector.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_EraseFront, std::vector<int>)->Range(8, 1 << 10);
+BENCHMARK_TEMPLATE(BM_EraseFront, steev::vector<int>)->Range(8, 1 << 10);
+BENCHMARK_TEMPLATE(BM_EraseFront, std::vector<std::string>)->Range(8, 1 << 10);
+BENCHMARK_TEMPLATE(BM_EraseFront, steev::vector<std::string>)
+    ->Range(8, 1 << 10);
+
+// Sums every element through the iterators
+template<typename Vector>
+void BM_Iterate(benchmark::State& state)
+{
+  Vector vector = filled<Vector>(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::int64_t sum = 0;
+    for (auto& element : vector) {
+      sum += element;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Iterate, std::vector<int>)->Range(8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Iterate, steev::vector<int>)->Range(8, 1 << 16);
+
+// Compares two equal vectors, the worst case for the dedup stage's key
+// comparisons
+template<typename Vector>
+void BM_Equal(benchmark::State& state)
+{
+  auto count = static_cast<std::size_t>(state.range(0));
+  Vector lhs = filled<Vector>(count);
+  Vector rhs = filled<Vector>(count);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs == rhs);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Equal, std::vector<std::int64_t>)->Range(8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Equal, steev::vector<std::int64_t>)->Range(8, 1 << 16);
+
+// Three-way comparison of vectors that differ only in their last element
+template<typename Vector>
+void BM_ThreeWay(benchmark::State& state)
+{
+  auto count = static_cast<std::size_t>(state.range(0));
+  Vector lhs = filled<Vector>(count);
+  Vector rhs = filled<Vector>(count);
+  rhs[count - 1]++;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs <=> rhs);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_ThreeWay, std::vector<int>)->Range(8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_ThreeWay, steev::vector<int>)->Range(8, 1 << 16);
+
+// Looks for a value that isn't there
+void BM_FindStd(benchmark::State& state)
+{
+  auto vector =
+      filled<std::vector<int>>(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::find(vector.begin(), vector.end(), -1));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindStd)->Range(8, 1 << 16);
+
+void BM_FindSteev(benchmark::State& state)
+{
+  auto vector =
+      filled<steev::vector<int>>(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(find(vector, -1));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindSteev)->Range(8, 1 << 16);
+
+// Re-sizes a reused receive buffer, zeroed or left for the reader to fill
+void BM_ResizeZeroed(benchmark::State& state)
+{
+  auto bytes = static_cast<std::size_t>(state.range(0));
+  steev::vector<char> buffer;
+  buffer.reserve(bytes);
+  for (auto _ : state) {
+    buffer.clear();
+    buffer.resize(bytes);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ResizeZeroed)->Range(1 << 12, 1 << 26);
+
+void BM_ResizeForOverwrite(benchmark::State& state)
+{
+  auto bytes = static_cast<std::size_t>(state.range(0));
+  steev::vector<char> buffer;
+  buffer.reserve(bytes);
+  for (auto _ : state) {
+    buffer.clear();
+    buffer.resize_for_overwrite(bytes);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ResizeForOverwrite)->Range(1 << 12, 1 << 26);
@@ -0,0 +1,93 @@
+#include <atomic>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "memory/smart_ptr/atomic_shared_ptr.hpp"
+#include "memory/smart_ptr/shared_ptr.hpp"
+#include "memory/smart_ptr/weak_ptr.hpp"
+
+// Several threads hammering the counts of one object. Every benchmark here
+// runs with 1 to 8 threads; the numbers are per thread.
+
+namespace
+{
+struct Payload
+{
+  int values[4] {};
+};
+
+std::shared_ptr<Payload> std_shared = std::make_shared<Payload>();
+steev::shared_ptr<Payload> steev_shared = steev::make_shared<Payload>();
+}  // namespace
+
+// Copying a shared_ptr that every thread reads
+void BM_ContendedCopyStd(benchmark::State& state)
+{
+  for (auto _ : state) {
+    std::shared_ptr<Payload> copy(std_shared);
+    benchmark::DoNotOptimize(copy.get());
+  }
+}
+BENCHMARK(BM_ContendedCopyStd)->ThreadRange(1, 8)->UseRealTime();
+
+void BM_ContendedCopySteev(benchmark::State& state)
+{
+  for (auto _ : state) {
+    steev::shared_ptr<Payload> copy(steev_shared);
+    benchmark::DoNotOptimize(copy.get());
+  }
+}
+BENCHMARK(BM_ContendedCopySteev)->ThreadRange(1, 8)->UseRealTime();
+
+// Locking a weak_ptr to an object every thread shares
+void BM_ContendedWeakLockStd(benchmark::State& state)
+{
+  std::weak_ptr<Payload> weak(std_shared);
+  for (auto _ : state) {
+    auto locked = weak.lock();
+    benchmark::DoNotOptimize(locked.get());
+  }
+}
+BENCHMARK(BM_ContendedWeakLockStd)->ThreadRange(1, 8)->UseRealTime();
+
+void BM_ContendedWeakLockSteev(benchmark::State& state)
+{
+  steev::weak_ptr<Payload> weak(steev_shared);
+  for (auto _ : state) {
+    auto locked = weak.lock();
+    benchmark::DoNotOptimize(locked.get());
+  }
+}
+BENCHMARK(BM_ContendedWeakLockSteev)->ThreadRange(1, 8)->UseRealTime();
+
+// Readers loading a published pointer while thread 0 keeps replacing it
+void BM_AtomicLoadStd(benchmark::State& state)
+{
+  static std::atomic<std::shared_ptr<Payload>> published(
+      std::make_shared<Payload>());
+  for (auto _ : state) {
+    if (state.thread_index() == 0) {
+      published.store(std::make_shared<Payload>());
+    } else {
+      auto loaded = published.load();
+      benchmark::DoNotOptimize(loaded.get());
+    }
+  }
+}
+BENCHMARK(BM_AtomicLoadStd)->ThreadRange(1, 8)->UseRealTime();
+
+void BM_AtomicLoadSteev(benchmark::State& state)
+{
+  static steev::atomic_shared_ptr<Payload> published(
+      steev::make_shared<Payload>());
+  for (auto _ : state) {
+    if (state.thread_index() == 0) {
+      published.store(steev::make_shared<Payload>());
+    } else {
+      auto loaded = published.load();
+      benchmark::DoNotOptimize(loaded.get());
+    }
+  }
+}
+BENCHMARK(BM_AtomicLoadSteev)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,107 @@
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "memory/smart_ptr/shared_ptr.hpp"
+#include "memory/smart_ptr/unique_ptr.hpp"
+#include "memory/smart_ptr/weak_ptr.hpp"
+
+// Single-threaded construct/copy/destroy costs, std:: next to steev::
+
+namespace
+{
+struct Payload
+{
+  int values[4] {};
+};
+}  // namespace
+
+// unique_ptr from a fresh allocation, then destroyed
+template<typename UniquePtr>
+void BM_UniquePtrCreate(benchmark::State& state)
+{
+  for (auto _ : state) {
+    UniquePtr ptr(new Payload);
+    benchmark::DoNotOptimize(ptr.get());
+  }
+}
+BENCHMARK_TEMPLATE(BM_UniquePtrCreate, std::unique_ptr<Payload>);
+BENCHMARK_TEMPLATE(BM_UniquePtrCreate, steev::unique_ptr<Payload>);
+
+// shared_ptr adopting a raw pointer: two allocations
+template<typename SharedPtr>
+void BM_SharedPtrFromRaw(benchmark::State& state)
+{
+  for (auto _ : state) {
+    SharedPtr ptr(new Payload);
+    benchmark::DoNotOptimize(ptr.get());
+  }
+}
+BENCHMARK_TEMPLATE(BM_SharedPtrFromRaw, std::shared_ptr<Payload>);
+BENCHMARK_TEMPLATE(BM_SharedPtrFromRaw, steev::shared_ptr<Payload>);
+BENCHMARK_TEMPLATE(BM_SharedPtrFromRaw, steev::local_shared_ptr<Payload>);
+
+// make_shared: object and counts in one allocation
+void BM_MakeSharedStd(benchmark::State& state)
+{
+  for (auto _ : state) {
+    auto ptr = std::make_shared<Payload>();
+    benchmark::DoNotOptimize(ptr.get());
+  }
+}
+BENCHMARK(BM_MakeSharedStd);
+
+void BM_MakeSharedSteev(benchmark::State& state)
+{
+  for (auto _ : state) {
+    auto ptr = steev::make_shared<Payload>();
+    benchmark::DoNotOptimize(ptr.get());
+  }
+}
+BENCHMARK(BM_MakeSharedSteev);
+
+void BM_MakeLocalSharedSteev(benchmark::State& state)
+{
+  for (auto _ : state) {
+    auto ptr = steev::make_local_shared<Payload>();
+    benchmark::DoNotOptimize(ptr.get());
+  }
+}
+BENCHMARK(BM_MakeLocalSharedSteev);
+
+// Copying and dropping a shared_ptr: one increment and one decrement
+template<typename SharedPtr>
+void BM_SharedPtrCopy(benchmark::State& state)
+{
+  SharedPtr ptr(new Payload);
+  for (auto _ : state) {
+    SharedPtr copy(ptr);
+    benchmark::DoNotOptimize(copy.get());
+  }
+}
+BENCHMARK_TEMPLATE(BM_SharedPtrCopy, std::shared_ptr<Payload>);
+BENCHMARK_TEMPLATE(BM_SharedPtrCopy, steev::shared_ptr<Payload>);
+BENCHMARK_TEMPLATE(BM_SharedPtrCopy, steev::local_shared_ptr<Payload>);
+
+// Creating a weak_ptr and locking it back into a shared_ptr
+void BM_WeakPtrLockStd(benchmark::State& state)
+{
+  std::shared_ptr<Payload> ptr(new Payload);
+  for (auto _ : state) {
+    std::weak_ptr<Payload> weak(ptr);
+    auto locked = weak.lock();
+    benchmark::DoNotOptimize(locked.get());
+  }
+}
+BENCHMARK(BM_WeakPtrLockStd);
+
+void BM_WeakPtrLockSteev(benchmark::State& state)
+{
+  steev::shared_ptr<Payload> ptr(new Payload);
+  for (auto _ : state) {
+    steev::weak_ptr<Payload> weak(ptr);
+    auto locked = weak.lock();
+    benchmark::DoNotOptimize(locked.get());
+  }
+}
+BENCHMARK(BM_WeakPtrLockSteev);
@@ -5,6 +5,11 @@ if(BUILD_TESTING)
   add_subdirectory(test)
 endif()
 
+option(BUILD_BENCHMARKS "Build the stdlib_bench benchmark suite" OFF)
+if(BUILD_BENCHMARKS)
+  add_subdirectory(bench)
+endif()
+
 add_custom_target(
     run-exe
     COMMAND stdlib_exe
@@ -1,109 +1,28 @@
 #pragma once
 
+#include <compare>
 #include <cstddef>
 #include <initializer_list>
-#include <iterator>
+#include <stdexcept>
+
+#include "containers/pointer_iterator.hpp"
+#include "containers/simd.hpp"
+
 namespace steev
 {
 template<typename T, std::size_t Capacity>
 class array
 {
-  class Iterator
-  {
-    T* ptr_;
-
-  public:
-    using iterator_category = std::random_access_iterator_tag;
-    using value_type = T;
-    using difference_type = std::ptrdiff_t;
-    using pointer = value_type*;
-    using reference = value_type&;
-
-    Iterator(T* ptr)
-        : ptr_(ptr)
-    {
-    }
-
-    // Dereference operator
-    reference operator*() const { return *ptr_; }
-
-    // Arrow operator
-    pointer operator->() const { return ptr_; }
-
-    // Addition with a difference type
-    Iterator operator+(difference_type incr) const
-    {
-      return Iterator(ptr_ + incr);
-    }
-
-    // Subtraction with a difference type
-    Iterator operator-(difference_type decr) const
-    {
-      return Iterator(ptr_ - decr);
-    }
-
-    // Increment operators (pre-increment and post-increment)
-    Iterator& operator++()
-    {
-      ++ptr_;
-      return *this;
-    }
-
-    Iterator operator++(int)
-    {
-      Iterator temp = *this;
-      ++ptr_;
-      return temp;
-    }
-
-    // Decrement operators (pre-decrement and post-decrement)
-    Iterator& operator--()
-    {
-      --ptr_;
-      return *this;
-    }
-
-    Iterator operator--(int)
-    {
-      Iterator temp = *this;
-      --ptr_;
-      return temp;
-    }
-
-    // Difference between two iterators
-    difference_type operator-(const Iterator& other) const
-    {
-      return ptr_ - other.ptr_;
-    }
-
-    // Compound assignment operators
-    Iterator& operator+=(difference_type incr)
-    {
-      ptr_ += incr;
-      return *this;
-    }
-
-    Iterator& operator-=(difference_type decr)
-    {
-      ptr_ -= decr;
-      return *this;
-    }
-
-    // Comparison operators
-    bool operator==(const Iterator& other) const { return ptr_ == other.ptr_; }
-    bool operator!=(const Iterator& other) const { return ptr_ != other.ptr_; }
-    bool operator<(const Iterator& other) const { return ptr_ < other.ptr_; }
-    bool operator<=(const Iterator& other) const { return ptr_ <= other.ptr_; }
-    bool operator>(const Iterator& other) const { return ptr_ > other.ptr_; }
-    bool operator>=(const Iterator& other) const { return ptr_ >= other.ptr_; }
-  };
+  using Iterator = pointer_iterator<T>;
 
   T data_[Capacity];
 
 public:
-  // initializer_list constructor
+  // Leaves trivially constructible elements uninitialized, like a plain array
+  constexpr array() = default;
 
-  array(std::initializer_list<T> list)
+  // initializer_list constructor
+  constexpr array(std::initializer_list<T> list)
   {
     std::size_t i = 0;
     for (const auto& elem : list) {
@@ -111,10 +30,19 @@ public:
     }
   }
 
-  Iterator begin() noexcept { return data_; }
-  Iterator end() noexcept { return data_[Capacity]; }
+  constexpr Iterator begin() noexcept { return data_; }
+  constexpr Iterator end() noexcept { return data_ + Capacity; }
 
-  T& at(std::size_t idx)
+  constexpr const T& operator[](std::size_t index) const
+  {
+    return data_[index];
+  }
+  constexpr T& operator[](std::size_t index) { return data_[index]; }
+
+  constexpr T* data() noexcept { return data_; }
+  constexpr const T* data() const noexcept { return data_; }
+
+  constexpr T& at(std::size_t idx)
   {
     if (idx >= Capacity) {
       throw std::out_of_range("Index out of bounds");
@@ -122,11 +50,40 @@ public:
     return data_[idx];
   }
 
-  T& front() noexcept { return data_; }
-  T& back() noexcept { return data_[Capacity - 1]; }
+  constexpr T& front() noexcept { return data_[0]; }
+  constexpr T& back() noexcept { return data_[Capacity - 1]; }
 
   constexpr std::size_t size() const noexcept { return Capacity; }
   constexpr bool empty() const noexcept { return Capacity == 0; }
   constexpr std::size_t capacity() const noexcept { return Capacity; }
+
+  constexpr void fill(const T& value) { simd::fill(data_, Capacity, value); }
+
+  friend constexpr bool operator==(const array& lhs, const array& rhs)
+  {
+    return simd::equal(lhs.data_, rhs.data_, Capacity);
+  }
+
+  // Lexicographic, like std::array
+  friend constexpr auto operator<=>(const array& lhs, const array& rhs)
+  {
+    using ordering = std::compare_three_way_result_t<T>;
+    std::size_t index = simd::mismatch(lhs.data_, rhs.data_, Capacity);
+    if (index == Capacity) {
+      return ordering(std::strong_ordering::equal);
+    }
+    return lhs.data_[index] <=> rhs.data_[index];
+  }
+
+  // Position of the first element equal to value, or end()
+  friend constexpr Iterator find(array& arr, const T& value)
+  {
+    return arr.data_ + simd::find(arr.data_, Capacity, value);
+  }
+
+  friend constexpr std::size_t count(const array& arr, const T& value)
+  {
+    return simd::count(arr.data_, Capacity, value);
+  }
 };
 }  // namespace steev
@@ -0,0 +1,363 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "memory/allocator.hpp"
+
+namespace steev
+{
+// Append-only vector that any number of threads can push_back to at once.
+// An append reserves its indices with one fetch_add on the size and then
+// constructs into them, so appenders never wait on each other. Elements
+// live in segments that double in size and are never moved: segment 0
+// holds FirstSegment elements, and segment k > 0 the FirstSegment << (k-1)
+// after them. Whichever appender first needs a segment allocates it and
+// publishes it with a compare-exchange; one that loses the race frees its
+// own copy.
+//
+// Every slot has a flag that its appender sets, with release, once the
+// element is constructed. size() counts reserved slots, some of which may
+// still be under construction, or empty for good because their constructor
+// threw. Readers on any thread go through the flags: at() only returns
+// constructed elements, and iteration skips the rest. Everything besides
+// appending and reading, including destruction, needs the vector to itself.
+template<typename T, std::size_t FirstSegment = 16>
+class concurrent_vector
+{
+  static_assert(std::has_single_bit(FirstSegment),
+                "FirstSegment has to be a power of two");
+  static_assert(std::is_nothrow_destructible_v<T>);
+
+  static constexpr std::size_t first_shift = std::countr_zero(FirstSegment);
+  static constexpr std::size_t max_segments =
+      std::numeric_limits<std::size_t>::digits - first_shift + 1;
+
+  static constexpr std::size_t segment_of(std::size_t index) noexcept
+  {
+    return static_cast<std::size_t>(std::bit_width(index >> first_shift));
+  }
+
+  static constexpr std::size_t segment_start(std::size_t segment) noexcept
+  {
+    return segment == 0 ? 0 : FirstSegment << (segment - 1);
+  }
+
+  static constexpr std::size_t segment_size(std::size_t segment) noexcept
+  {
+    return segment == 0 ? FirstSegment : FirstSegment << (segment - 1);
+  }
+
+  using flag = std::atomic<bool>;
+
+  // Visits the constructed elements below the size() seen when it was made.
+  // Unconstructed slots are skipped, and all iterators past their last
+  // element compare equal to end().
+  template<bool Const>
+  class basic_iterator
+  {
+    using Vector =
+        std::conditional_t<Const, const concurrent_vector, concurrent_vector>;
+
+    Vector* vector_ = nullptr;
+    std::size_t index_ = 0;
+    std::size_t limit_ = 0;
+
+    friend class concurrent_vector;
+    friend class basic_iterator<!Const>;
+
+    basic_iterator(Vector* vector,
+                   std::size_t index,
+                   std::size_t limit) noexcept
+        : vector_(vector)
+        , index_(index)
+        , limit_(limit)
+    {
+      skip_unconstructed();
+    }
+
+    void skip_unconstructed() noexcept
+    {
+      while (index_ < limit_ && !vector_->constructed(index_)) {
+        ++index_;
+      }
+    }
+
+    bool at_end() const noexcept { return index_ >= limit_; }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    basic_iterator() noexcept = default;
+
+    // Mutable iterators convert to const ones
+    template<bool OtherConst>
+      requires(Const && !OtherConst)
+    basic_iterator(const basic_iterator<OtherConst>& other) noexcept
+        : vector_(other.vector_)
+        , index_(other.index_)
+        , limit_(other.limit_)
+    {
+    }
+
+    // Dereference operator
+    reference operator*() const { return (*vector_)[index_]; }
+
+    // Arrow operator
+    pointer operator->() const { return &**this; }
+
+    // Increment operators (pre-increment and post-increment)
+    basic_iterator& operator++() noexcept
+    {
+      ++index_;
+      skip_unconstructed();
+      return *this;
+    }
+
+    basic_iterator operator++(int) noexcept
+    {
+      basic_iterator temp = *this;
+      ++*this;
+      return temp;
+    }
+
+    // Comparison operators
+    friend bool operator==(const basic_iterator& lhs,
+                           const basic_iterator& rhs) noexcept
+    {
+      if (lhs.at_end() || rhs.at_end()) {
+        return lhs.at_end() == rhs.at_end();
+      }
+      return lhs.index_ == rhs.index_;
+    }
+  };
+
+  std::array<std::atomic<T*>, max_segments> segments_ {};
+  std::array<std::atomic<flag*>, max_segments> flags_ {};
+  std::atomic<std::size_t> size_ = 0;
+
+  // Returns segments[index], allocating it if no other thread has yet.
+  // Flag segments start out all unset.
+  template<typename U>
+  static U* segment(std::array<std::atomic<U*>, max_segments>& segments,
+                    std::size_t index)
+  {
+    U* current = segments[index].load(std::memory_order_acquire);
+    if (current != nullptr) {
+      return current;
+    }
+
+    std::size_t count = segment_size(index);
+    U* fresh = allocator<U>().allocate(count);
+    if constexpr (std::is_same_v<U, flag>) {
+      for (std::size_t i = 0; i < count; i++) {
+        std::construct_at(fresh + i, false);
+      }
+    }
+    if (segments[index].compare_exchange_strong(current,
+                                                fresh,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire))
+    {
+      return fresh;
+    }
+    allocator<U>().deallocate(fresh, count);
+    return current;
+  }
+
+  // Whether the element at index is constructed; acquiring the flag makes
+  // the element visible to this thread
+  bool constructed(std::size_t index) const noexcept
+  {
+    std::size_t seg = segment_of(index);
+    const flag* flags = flags_[seg].load(std::memory_order_acquire);
+    return flags != nullptr
+        && flags[index - segment_start(seg)].load(std::memory_order_acquire);
+  }
+
+  // Only for constructed elements, whose segments are known to exist
+  T* slot(std::size_t index) const noexcept
+  {
+    assert(constructed(index));
+    std::size_t seg = segment_of(index);
+    return segments_[seg].load(std::memory_order_acquire) + index
+        - segment_start(seg);
+  }
+
+  // Makes sure every segment covering [first, last) exists
+  void allocate_range(std::size_t first, std::size_t last)
+  {
+    for (std::size_t seg = segment_of(first); seg <= segment_of(last - 1);
+         seg++)
+    {
+      segment(flags_, seg);
+      segment(segments_, seg);
+    }
+  }
+
+  // If allocating or constructing throws, the slot stays unconstructed for
+  // good and readers keep skipping it
+  template<typename... Args>
+  void construct(std::size_t index, Args&&... args)
+  {
+    std::size_t seg = segment_of(index);
+    std::size_t offset = index - segment_start(seg);
+    flag* flags = segment(flags_, seg);
+    std::construct_at(segment(segments_, seg) + offset,
+                      std::forward<Args>(args)...);
+    flags[offset].store(true, std::memory_order_release);
+  }
+
+  void release() noexcept
+  {
+    for (std::size_t seg = 0; seg < max_segments; seg++) {
+      T* data = segments_[seg].load(std::memory_order_relaxed);
+      flag* flags = flags_[seg].load(std::memory_order_relaxed);
+      if (data != nullptr && flags != nullptr) {
+        for (std::size_t i = 0; i < segment_size(seg); i++) {
+          if (flags[i].load(std::memory_order_relaxed)) {
+            std::destroy_at(data + i);
+          }
+        }
+      }
+      if (data != nullptr) {
+        allocator<T>().deallocate(data, segment_size(seg));
+        segments_[seg].store(nullptr, std::memory_order_relaxed);
+      }
+      if (flags != nullptr) {
+        allocator<flag>().deallocate(flags, segment_size(seg));
+        flags_[seg].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+    size_.store(0, std::memory_order_relaxed);
+  }
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  concurrent_vector() noexcept = default;
+
+  concurrent_vector(const concurrent_vector&) = delete;
+  concurrent_vector& operator=(const concurrent_vector&) = delete;
+
+  ~concurrent_vector() { release(); }
+
+  // Slots handed out so far, constructed or not
+  std::size_t size() const noexcept
+  {
+    return size_.load(std::memory_order_acquire);
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  // Elements that fit in the segments allocated so far without a gap
+  std::size_t capacity() const noexcept
+  {
+    std::size_t seg = 0;
+    while (seg < max_segments
+           && segments_[seg].load(std::memory_order_acquire) != nullptr)
+    {
+      seg++;
+    }
+    return seg == 0 ? 0 : segment_start(seg - 1) + segment_size(seg - 1);
+  }
+
+  // Allocates the segments for new_capacity elements; safe to call while
+  // other threads append
+  void reserve(std::size_t new_capacity)
+  {
+    if (new_capacity > 0) {
+      allocate_range(0, new_capacity);
+    }
+  }
+
+  // The element has to be constructed, e.g. returned by an append that
+  // happened-before, or reached through at() or an iterator
+  T& operator[](std::size_t index) noexcept { return *slot(index); }
+  const T& operator[](std::size_t index) const noexcept
+  {
+    return *slot(index);
+  }
+
+  // Throws for slots that aren't reserved, or aren't constructed yet
+  T& at(std::size_t idx)
+  {
+    if (idx >= size()) {
+      throw std::out_of_range("Index out of bounds");
+    }
+    if (!constructed(idx)) {
+      throw std::out_of_range("Element not constructed");
+    }
+    return *slot(idx);
+  }
+
+  const T& at(std::size_t idx) const
+  {
+    if (idx >= size()) {
+      throw std::out_of_range("Index out of bounds");
+    }
+    if (!constructed(idx)) {
+      throw std::out_of_range("Element not constructed");
+    }
+    return *slot(idx);
+  }
+
+  iterator begin() noexcept { return {this, 0, size()}; }
+  iterator end() noexcept { return {this, size(), size()}; }
+  const_iterator begin() const noexcept { return {this, 0, size()}; }
+  const_iterator end() const noexcept { return {this, size(), size()}; }
+
+  template<typename... Args>
+  iterator emplace_back(Args&&... args)
+  {
+    std::size_t index = size_.fetch_add(1, std::memory_order_relaxed);
+    construct(index, std::forward<Args>(args)...);
+    return {this, index, size()};
+  }
+
+  iterator push_back(const T& element) { return emplace_back(element); }
+  iterator push_back(T&& element) { return emplace_back(std::move(element)); }
+
+  // Appends count value-initialized elements in one reservation and returns
+  // the first. If one throws, the ones before it stay constructed.
+  iterator grow_by(std::size_t count)
+  {
+    std::size_t first = size_.fetch_add(count, std::memory_order_relaxed);
+    for (std::size_t i = first; i < first + count; i++) {
+      construct(i);
+    }
+    return {this, first, size()};
+  }
+
+  iterator grow_by(std::size_t count, const T& element)
+  {
+    std::size_t first = size_.fetch_add(count, std::memory_order_relaxed);
+    for (std::size_t i = first; i < first + count; i++) {
+      construct(i, element);
+    }
+    return {this, first, size()};
+  }
+
+  // Destroys every element and frees the segments; not thread safe
+  void clear() noexcept { release(); }
+};
+}  // namespace steev
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "containers/hash_table.hpp"
+
+namespace steev
+{
+namespace detail
+{
+template<typename Key, typename T>
+struct map_policy
+{
+  static constexpr bool constant_elements = false;
+
+  static const Key& key(const std::pair<const Key, T>& value) noexcept
+  {
+    return value.first;
+  }
+
+  // The key is moved out from under its const, as node handles do; the
+  // source is destroyed straight after
+  static void transfer(std::pair<const Key, T>* dest,
+                       std::pair<const Key, T>& source) noexcept(
+      std::is_nothrow_move_constructible_v<Key>
+      && std::is_nothrow_move_constructible_v<T>)
+  {
+    std::construct_at(dest,
+                      std::move(const_cast<Key&>(source.first)),
+                      std::move(source.second));
+  }
+};
+}  // namespace detail
+
+// Hash map that keeps its pairs in one flat array of slots rather than a
+// node each, found through the SSE2-probed control bytes of
+// detail::hash_table. Inserting may rehash, which moves every element and
+// invalidates iterators and references; erasing moves nothing.
+template<typename Key,
+         typename T,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>>
+class flat_hash_map
+    : public detail::hash_table<std::pair<const Key, T>,
+                                Key,
+                                detail::map_policy<Key, T>,
+                                Hash,
+                                KeyEqual>
+{
+  using base = detail::hash_table<std::pair<const Key, T>,
+                                  Key,
+                                  detail::map_policy<Key, T>,
+                                  Hash,
+                                  KeyEqual>;
+
+public:
+  using mapped_type = T;
+  using typename base::const_iterator;
+  using typename base::iterator;
+  using typename base::value_type;
+
+  flat_hash_map() = default;
+
+  flat_hash_map(std::initializer_list<value_type> elements)
+  {
+    this->reserve(elements.size());
+    for (const value_type& element : elements) {
+      insert(element);
+    }
+  }
+
+  // Constructs the mapped value from args only if key isn't there yet
+  template<typename K = Key, typename... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+  {
+    if (this->insert_may_grow()) {
+      // key and args may refer into the table, so build the pair before
+      // growing moves them
+      auto it = this->find(key);
+      if (it != this->end()) {
+        return {it, false};
+      }
+      return this->emplace_value(
+          std::piecewise_construct,
+          std::forward_as_tuple(std::forward<K>(key)),
+          std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+    auto slot = this->find_or_prepare_insert(key);
+    if (slot.inserted) {
+      std::construct_at(this->slot_at(slot.index),
+                        std::piecewise_construct,
+                        std::forward_as_tuple(std::forward<K>(key)),
+                        std::forward_as_tuple(std::forward<Args>(args)...));
+      this->commit_insert(slot);
+    }
+    return {this->iterator_at(slot.index), slot.inserted};
+  }
+
+  template<typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args)
+  {
+    return this->emplace_value(std::forward<Args>(args)...);
+  }
+
+  std::pair<iterator, bool> insert(const value_type& element)
+  {
+    return try_emplace(element.first, element.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& element)
+  {
+    return try_emplace(element.first, std::move(element.second));
+  }
+
+  template<typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& value)
+  {
+    auto result = try_emplace(key, std::forward<M>(value));
+    if (!result.second) {
+      result.first->second = std::forward<M>(value);
+    }
+    return result;
+  }
+
+  T& operator[](const Key& key) { return try_emplace(key).first->second; }
+  T& operator[](Key&& key)
+  {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  template<typename K>
+  T& at(const K& key)
+  {
+    auto it = this->find(key);
+    if (it == this->end()) {
+      throw std::out_of_range("Key not found");
+    }
+    return it->second;
+  }
+
+  template<typename K>
+  const T& at(const K& key) const
+  {
+    auto it = this->find(key);
+    if (it == this->end()) {
+      throw std::out_of_range("Key not found");
+    }
+    return it->second;
+  }
+};
+}  // namespace steev
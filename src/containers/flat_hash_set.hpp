@@ -0,0 +1,87 @@
+#pragma once
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "containers/hash_table.hpp"
+
+namespace steev
+{
+namespace detail
+{
+template<typename Key>
+struct set_policy
+{
+  static constexpr bool constant_elements = true;
+
+  static const Key& key(const Key& value) noexcept { return value; }
+
+  static void transfer(Key* dest, Key& source) noexcept(
+      std::is_nothrow_move_constructible_v<Key>)
+  {
+    std::construct_at(dest, std::move(source));
+  }
+};
+}  // namespace detail
+
+// Hash set counterpart of flat_hash_map, with the same layout and the same
+// iterator invalidation rules
+template<typename Key,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>>
+class flat_hash_set
+    : public detail::
+          hash_table<Key, Key, detail::set_policy<Key>, Hash, KeyEqual>
+{
+  using base = detail::
+      hash_table<Key, Key, detail::set_policy<Key>, Hash, KeyEqual>;
+
+public:
+  using typename base::iterator;
+
+  flat_hash_set() = default;
+
+  flat_hash_set(std::initializer_list<Key> elements)
+  {
+    this->reserve(elements.size());
+    for (const Key& element : elements) {
+      insert(element);
+    }
+  }
+
+  std::pair<iterator, bool> insert(const Key& element)
+  {
+    return insert_key(element);
+  }
+
+  std::pair<iterator, bool> insert(Key&& element)
+  {
+    return insert_key(std::move(element));
+  }
+
+  template<typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args)
+  {
+    return this->emplace_value(std::forward<Args>(args)...);
+  }
+
+private:
+  template<typename K>
+  std::pair<iterator, bool> insert_key(K&& element)
+  {
+    if (this->insert_may_grow()) {
+      // element may be in the table, so copy it before growing moves it
+      return this->emplace_value(std::forward<K>(element));
+    }
+    auto slot = this->find_or_prepare_insert(element);
+    if (slot.inserted) {
+      std::construct_at(this->slot_at(slot.index), std::forward<K>(element));
+      this->commit_insert(slot);
+    }
+    return {this->iterator_at(slot.index), slot.inserted};
+  }
+};
+}  // namespace steev
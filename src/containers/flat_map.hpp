@@ -0,0 +1,449 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "containers/sorted_search.hpp"
+#include "containers/vector.hpp"
+
+namespace steev
+{
+// Map stored as two parallel steev::vectors, the sorted keys and their
+// values, for tables built once and searched many times. A search only
+// streams through keys, and through the Layout's copy of them when that
+// is eytzinger_layout, never through values. Building from unsorted input
+// sorts and drops duplicates once, keeping the first value given for each
+// key. insert and erase work but shift everything after the position, so
+// they cost O(n).
+template<typename Key,
+         typename T,
+         typename Compare = std::less<Key>,
+         typename Layout = sorted_layout>
+class flat_map
+{
+  static constexpr bool transparent =
+      requires { typename Compare::is_transparent; };
+
+  // Random access iterator yielding a pair of references, one into each
+  // vector
+  template<bool Const>
+  class basic_iterator
+  {
+    using Value = std::conditional_t<Const, const T, T>;
+
+    const Key* key_ = nullptr;
+    Value* value_ = nullptr;
+
+    friend class flat_map;
+    friend class basic_iterator<!Const>;
+
+    basic_iterator(const Key* key, Value* value) noexcept
+        : key_(key)
+        , value_(value)
+    {
+    }
+
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = std::pair<Key, T>;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::pair<const Key&, Value&>;
+
+    // Gives operator-> something to point at
+    struct pointer
+    {
+      reference pair;
+
+      const reference* operator->() const noexcept { return &pair; }
+    };
+
+    basic_iterator() noexcept = default;
+
+    // Mutable iterators convert to const ones
+    template<bool OtherConst>
+      requires(Const && !OtherConst)
+    basic_iterator(const basic_iterator<OtherConst>& other) noexcept
+        : key_(other.key_)
+        , value_(other.value_)
+    {
+    }
+
+    // Dereference operator
+    reference operator*() const { return {*key_, *value_}; }
+
+    // Arrow operator
+    pointer operator->() const { return {**this}; }
+
+    // Subscript operator
+    reference operator[](difference_type offset) const
+    {
+      return *(*this + offset);
+    }
+
+    // Increment operators (pre-increment and post-increment)
+    basic_iterator& operator++() noexcept
+    {
+      ++key_;
+      ++value_;
+      return *this;
+    }
+
+    basic_iterator operator++(int) noexcept
+    {
+      basic_iterator temp = *this;
+      ++*this;
+      return temp;
+    }
+
+    // Decrement operators (pre-decrement and post-decrement)
+    basic_iterator& operator--() noexcept
+    {
+      --key_;
+      --value_;
+      return *this;
+    }
+
+    basic_iterator operator--(int) noexcept
+    {
+      basic_iterator temp = *this;
+      --*this;
+      return temp;
+    }
+
+    // Compound assignment operators
+    basic_iterator& operator+=(difference_type incr) noexcept
+    {
+      key_ += incr;
+      value_ += incr;
+      return *this;
+    }
+
+    basic_iterator& operator-=(difference_type decr) noexcept
+    {
+      key_ -= decr;
+      value_ -= decr;
+      return *this;
+    }
+
+    // Addition and subtraction with a difference type
+    friend basic_iterator operator+(basic_iterator it,
+                                    difference_type incr) noexcept
+    {
+      return it += incr;
+    }
+
+    friend basic_iterator operator+(difference_type incr,
+                                    basic_iterator it) noexcept
+    {
+      return it += incr;
+    }
+
+    friend basic_iterator operator-(basic_iterator it,
+                                    difference_type decr) noexcept
+    {
+      return it -= decr;
+    }
+
+    // Difference between two iterators
+    friend difference_type operator-(const basic_iterator& lhs,
+                                     const basic_iterator& rhs) noexcept
+    {
+      return lhs.key_ - rhs.key_;
+    }
+
+    // Comparison operators
+    friend bool operator==(const basic_iterator& lhs,
+                           const basic_iterator& rhs) noexcept
+    {
+      return lhs.key_ == rhs.key_;
+    }
+
+    friend std::strong_ordering operator<=>(const basic_iterator& lhs,
+                                            const basic_iterator& rhs) noexcept
+    {
+      return lhs.key_ <=> rhs.key_;
+    }
+  };
+
+  vector<Key> keys_;
+  vector<T> values_;
+  detail::search_index<Key, Layout> index_;
+  [[no_unique_address]] Compare compare_;
+
+  // Sorts both vectors by key through one permutation and keeps the first
+  // entry of each run of equivalent keys
+  void sort_unique()
+  {
+    if (keys_.size() != values_.size()) {
+      throw std::invalid_argument("Key and value counts differ");
+    }
+    vector<std::size_t> order(keys_.size(), for_overwrite);
+    std::iota(order.begin(), order.end(), std::size_t {0});
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [this](std::size_t lhs, std::size_t rhs)
+                     { return compare_(keys_[lhs], keys_[rhs]); });
+
+    vector<Key> keys;
+    vector<T> values;
+    keys.reserve(order.size());
+    values.reserve(order.size());
+    for (std::size_t index : order) {
+      if (keys.empty() || compare_(keys.back(), keys_[index])) {
+        keys.push_back(std::move(keys_[index]));
+        values.push_back(std::move(values_[index]));
+      }
+    }
+    keys_.swap(keys);
+    values_.swap(values);
+    index_.build(keys_.data(), keys_.size());
+  }
+
+  // Index of the first key not ordered before key, or with Upper, the
+  // first ordered after it
+  template<bool Upper, typename K>
+  std::size_t bound(const K& key) const
+  {
+    return index_.partition(keys_.data(),
+                            keys_.size(),
+                            [&](const Key& element)
+                            {
+                              if constexpr (Upper) {
+                                return !compare_(key, element);
+                              } else {
+                                return static_cast<bool>(
+                                    compare_(element, key));
+                              }
+                            });
+  }
+
+  template<typename K>
+  std::size_t find_index(const K& key) const
+  {
+    std::size_t index = bound<false>(key);
+    if (index != keys_.size() && compare_(key, keys_[index])) {
+      return keys_.size();
+    }
+    return index;
+  }
+
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using key_compare = Compare;
+  using size_type = std::size_t;
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  flat_map() = default;
+
+  // Takes keys[i] -> values[i] in any order, sorting by key and keeping
+  // the first value of a repeated key
+  flat_map(vector<Key> keys,
+           vector<T> values,
+           const Compare& compare = Compare())
+      : keys_(std::move(keys))
+      , values_(std::move(values))
+      , compare_(compare)
+  {
+    sort_unique();
+  }
+
+  flat_map(sorted_unique_t,
+           vector<Key> keys,
+           vector<T> values,
+           const Compare& compare = Compare())
+      : keys_(std::move(keys))
+      , values_(std::move(values))
+      , compare_(compare)
+  {
+    if (keys_.size() != values_.size()) {
+      throw std::invalid_argument("Key and value counts differ");
+    }
+    index_.build(keys_.data(), keys_.size());
+  }
+
+  // Takes pairs in any order
+  template<std::input_iterator InputIt>
+  flat_map(InputIt first, InputIt last, const Compare& compare = Compare())
+      : compare_(compare)
+  {
+    for (; first != last; ++first) {
+      keys_.push_back(first->first);
+      values_.push_back(first->second);
+    }
+    sort_unique();
+  }
+
+  flat_map(std::initializer_list<value_type> pairs,
+           const Compare& compare = Compare())
+      : flat_map(pairs.begin(), pairs.end(), compare)
+  {
+  }
+
+  iterator begin() noexcept { return {keys_.data(), values_.data()}; }
+  iterator end() noexcept { return begin() + ssize(); }
+  const_iterator begin() const noexcept
+  {
+    return {keys_.data(), values_.data()};
+  }
+  const_iterator end() const noexcept { return begin() + ssize(); }
+
+  std::size_t size() const noexcept { return keys_.size(); }
+  std::ptrdiff_t ssize() const noexcept
+  {
+    return static_cast<std::ptrdiff_t>(keys_.size());
+  }
+  bool empty() const noexcept { return keys_.empty(); }
+
+  // The sorted keys and their values, index for index
+  const vector<Key>& keys() const noexcept { return keys_; }
+  const vector<T>& values() const noexcept { return values_; }
+
+  void clear() noexcept
+  {
+    keys_.clear();
+    values_.clear();
+    index_.build(keys_.data(), 0);
+  }
+
+  iterator find(const Key& key)
+  {
+    return begin() + static_cast<std::ptrdiff_t>(find_index(key));
+  }
+
+  const_iterator find(const Key& key) const
+  {
+    return begin() + static_cast<std::ptrdiff_t>(find_index(key));
+  }
+
+  // Lookups take any key type when Compare is transparent
+  template<typename K>
+    requires transparent
+  iterator find(const K& key)
+  {
+    return begin() + static_cast<std::ptrdiff_t>(find_index(key));
+  }
+
+  template<typename K>
+    requires transparent
+  const_iterator find(const K& key) const
+  {
+    return begin() + static_cast<std::ptrdiff_t>(find_index(key));
+  }
+
+  bool contains(const Key& key) const { return find_index(key) != size(); }
+
+  template<typename K>
+    requires transparent
+  bool contains(const K& key) const
+  {
+    return find_index(key) != size();
+  }
+
+  std::size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+  T& at(const Key& key)
+  {
+    std::size_t index = find_index(key);
+    if (index == size()) {
+      throw std::out_of_range("Key not found");
+    }
+    return values_[index];
+  }
+
+  const T& at(const Key& key) const
+  {
+    std::size_t index = find_index(key);
+    if (index == size()) {
+      throw std::out_of_range("Key not found");
+    }
+    return values_[index];
+  }
+
+  iterator lower_bound(const Key& key)
+  {
+    return begin() + static_cast<std::ptrdiff_t>(bound<false>(key));
+  }
+
+  const_iterator lower_bound(const Key& key) const
+  {
+    return begin() + static_cast<std::ptrdiff_t>(bound<false>(key));
+  }
+
+  iterator upper_bound(const Key& key)
+  {
+    return begin() + static_cast<std::ptrdiff_t>(bound<true>(key));
+  }
+
+  const_iterator upper_bound(const Key& key) const
+  {
+    return begin() + static_cast<std::ptrdiff_t>(bound<true>(key));
+  }
+
+  // Constructs the value from args only if key isn't there yet
+  template<typename K = Key, typename... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+  {
+    std::size_t index = bound<false>(key);
+    auto position = static_cast<std::ptrdiff_t>(index);
+    if (index != size() && !compare_(key, keys_[index])) {
+      return {begin() + position, false};
+    }
+    values_.emplace(values_.begin() + position, std::forward<Args>(args)...);
+    try {
+      keys_.emplace(keys_.begin() + position, std::forward<K>(key));
+    } catch (...) {
+      values_.erase(values_.begin() + position);
+      throw;
+    }
+    index_.build(keys_.data(), keys_.size());
+    return {begin() + position, true};
+  }
+
+  std::pair<iterator, bool> insert(const value_type& pair)
+  {
+    return try_emplace(pair.first, pair.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& pair)
+  {
+    return try_emplace(std::move(pair.first), std::move(pair.second));
+  }
+
+  T& operator[](const Key& key) { return (*try_emplace(key).first).second; }
+
+  iterator erase(const_iterator it)
+  {
+    auto position = it - begin();
+    keys_.erase(keys_.begin() + position);
+    values_.erase(values_.begin() + position);
+    index_.build(keys_.data(), keys_.size());
+    return begin() + position;
+  }
+
+  std::size_t erase(const Key& key)
+  {
+    std::size_t index = find_index(key);
+    if (index == size()) {
+      return 0;
+    }
+    erase(begin() + static_cast<std::ptrdiff_t>(index));
+    return 1;
+  }
+
+  friend bool operator==(const flat_map& lhs, const flat_map& rhs)
+  {
+    return lhs.keys_ == rhs.keys_ && lhs.values_ == rhs.values_;
+  }
+};
+}  // namespace steev
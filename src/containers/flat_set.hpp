@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "containers/pointer_iterator.hpp"
+#include "containers/sorted_search.hpp"
+#include "containers/vector.hpp"
+
+namespace steev
+{
+// Set stored as one sorted steev::vector of keys, for tables built once and
+// searched many times. Building from unsorted keys sorts and drops
+// duplicates once; lookups go through the search Layout picked in
+// sorted_search.hpp. insert and erase work but shift the keys after the
+// position, so they cost O(n).
+template<typename Key,
+         typename Compare = std::less<Key>,
+         typename Layout = sorted_layout>
+class flat_set
+{
+  using Iterator = pointer_iterator<const Key>;
+
+  static constexpr bool transparent =
+      requires { typename Compare::is_transparent; };
+
+  vector<Key> keys_;
+  detail::search_index<Key, Layout> index_;
+  [[no_unique_address]] Compare compare_;
+
+  // Sorts keys_ and keeps the first of each run of equivalent keys
+  void sort_unique()
+  {
+    std::stable_sort(keys_.begin(), keys_.end(), compare_);
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < keys_.size(); i++) {
+      if (kept == 0 || compare_(keys_[kept - 1], keys_[i])) {
+        if (kept != i) {
+          keys_[kept] = std::move(keys_[i]);
+        }
+        kept++;
+      }
+    }
+    while (keys_.size() > kept) {
+      keys_.pop_back();
+    }
+    index_.build(keys_.data(), keys_.size());
+  }
+
+  // Index of the first key not ordered before key, or with Upper, the
+  // first ordered after it
+  template<bool Upper, typename K>
+  std::size_t bound(const K& key) const
+  {
+    return index_.partition(keys_.data(),
+                            keys_.size(),
+                            [&](const Key& element)
+                            {
+                              if constexpr (Upper) {
+                                return !compare_(key, element);
+                              } else {
+                                return static_cast<bool>(
+                                    compare_(element, key));
+                              }
+                            });
+  }
+
+  template<typename K>
+  Iterator find_key(const K& key) const
+  {
+    std::size_t index = bound<false>(key);
+    if (index == keys_.size() || compare_(key, keys_[index])) {
+      return end();
+    }
+    return keys_.data() + index;
+  }
+
+public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using size_type = std::size_t;
+  using iterator = Iterator;
+  using const_iterator = Iterator;
+
+  flat_set() = default;
+
+  // Takes keys in any order, sorting them and dropping duplicates
+  explicit flat_set(vector<Key> keys, const Compare& compare = Compare())
+      : keys_(std::move(keys))
+      , compare_(compare)
+  {
+    sort_unique();
+  }
+
+  flat_set(sorted_unique_t,
+           vector<Key> keys,
+           const Compare& compare = Compare())
+      : keys_(std::move(keys))
+      , compare_(compare)
+  {
+    index_.build(keys_.data(), keys_.size());
+  }
+
+  template<std::input_iterator InputIt>
+  flat_set(InputIt first, InputIt last, const Compare& compare = Compare())
+      : compare_(compare)
+  {
+    keys_.insert(keys_.end(), first, last);
+    sort_unique();
+  }
+
+  flat_set(std::initializer_list<Key> keys,
+           const Compare& compare = Compare())
+      : flat_set(keys.begin(), keys.end(), compare)
+  {
+  }
+
+  Iterator begin() const noexcept { return keys_.data(); }
+  Iterator end() const noexcept { return keys_.data() + keys_.size(); }
+
+  std::size_t size() const noexcept { return keys_.size(); }
+  bool empty() const noexcept { return keys_.empty(); }
+
+  // The sorted keys
+  const vector<Key>& keys() const noexcept { return keys_; }
+
+  void clear() noexcept
+  {
+    keys_.clear();
+    index_.build(keys_.data(), 0);
+  }
+
+  Iterator find(const Key& key) const { return find_key(key); }
+
+  // Lookups take any key type when Compare is transparent
+  template<typename K>
+    requires transparent
+  Iterator find(const K& key) const
+  {
+    return find_key(key);
+  }
+
+  bool contains(const Key& key) const { return find(key) != end(); }
+
+  template<typename K>
+    requires transparent
+  bool contains(const K& key) const
+  {
+    return find(key) != end();
+  }
+
+  std::size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+  Iterator lower_bound(const Key& key) const
+  {
+    return keys_.data() + bound<false>(key);
+  }
+
+  Iterator upper_bound(const Key& key) const
+  {
+    return keys_.data() + bound<true>(key);
+  }
+
+  template<typename K>
+  std::pair<Iterator, bool> insert(K&& key)
+  {
+    std::size_t index = bound<false>(key);
+    if (index != keys_.size() && !compare_(key, keys_[index])) {
+      return {keys_.data() + index, false};
+    }
+    keys_.emplace(keys_.begin() + static_cast<std::ptrdiff_t>(index),
+                  std::forward<K>(key));
+    index_.build(keys_.data(), keys_.size());
+    return {keys_.data() + index, true};
+  }
+
+  Iterator erase(Iterator it)
+  {
+    auto index = static_cast<std::size_t>(&*it - keys_.data());
+    keys_.erase(keys_.begin() + static_cast<std::ptrdiff_t>(index));
+    index_.build(keys_.data(), keys_.size());
+    return keys_.data() + index;
+  }
+
+  std::size_t erase(const Key& key)
+  {
+    Iterator it = find(key);
+    if (it == end()) {
+      return 0;
+    }
+    erase(it);
+    return 1;
+  }
+
+  friend bool operator==(const flat_set& lhs, const flat_set& rhs)
+  {
+    return lhs.keys_ == rhs.keys_;
+  }
+};
+}  // namespace steev
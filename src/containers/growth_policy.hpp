@@ -0,0 +1,45 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace steev
+{
+// Growth policies pick the capacity steev::vector moves to once it runs out
+// of room. next_capacity gets the current capacity and the number of
+// elements that must fit. When round_to_allocation is set, the vector also
+// asks its allocator for any slack in the block it got back and counts it
+// as capacity.
+
+// Multiplies the capacity by Numerator / Denominator
+template<std::size_t Numerator, std::size_t Denominator>
+struct geometric_growth
+{
+  static_assert(Numerator > Denominator, "The capacity has to grow");
+
+  static constexpr bool round_to_allocation = false;
+
+  static constexpr std::size_t next_capacity(std::size_t capacity,
+                                             std::size_t required) noexcept
+  {
+    // Split up so capacity * Numerator can't overflow
+    std::size_t grown = capacity / Denominator * Numerator
+        + capacity % Denominator * Numerator / Denominator;
+    return std::max(grown, required);
+  }
+};
+
+using doubling_growth = geometric_growth<2, 1>;
+
+// Wastes at most a third of the buffer instead of half, and lets a freed
+// run of earlier buffers be reused for a later one
+using one_and_half_growth = geometric_growth<3, 2>;
+
+// Base's capacities, plus whatever the allocator's size class rounds the
+// block up to (malloc_usable_size for steev::allocator on glibc)
+template<typename Base = doubling_growth>
+struct size_class_growth : Base
+{
+  static constexpr bool round_to_allocation = true;
+};
+}  // namespace steev
@@ -0,0 +1,693 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "containers/simd.hpp"
+#include "containers/vector.hpp"
+#include "memory/allocator.hpp"
+
+// Open-addressing table behind steev::flat_hash_map and flat_hash_set, laid
+// out like Abseil's Swiss tables. Each slot has a control byte: the top bit
+// set means empty or deleted, clear means full with the low seven bits
+// holding seven bits of the element's hash (h2). A lookup loads the control
+// bytes of a 16-slot group at once, compares all of them against h2 with
+// SSE2, and only compares keys where the bytes match, so a miss rarely
+// touches the slots at all. The rest of the hash (h1) picks the first group;
+// groups are probed triangularly from there until one has an empty byte.
+
+namespace steev::detail
+{
+using ctrl_t = std::int8_t;
+
+inline constexpr ctrl_t ctrl_empty = -128;
+inline constexpr ctrl_t ctrl_deleted = -2;
+
+// One bit per slot of a group, lowest slot first
+class group_mask
+{
+  std::uint32_t bits_;
+
+public:
+  explicit group_mask(std::uint32_t bits) noexcept
+      : bits_(bits)
+  {
+  }
+
+  explicit operator bool() const noexcept { return bits_ != 0; }
+
+  std::size_t lowest() const noexcept
+  {
+    return static_cast<std::size_t>(std::countr_zero(bits_));
+  }
+
+  void clear_lowest() noexcept { bits_ &= bits_ - 1; }
+};
+
+// Control bytes of 16 consecutive slots
+class group
+{
+public:
+  static constexpr std::size_t width = 16;
+
+#ifdef STEEV_SIMD_X86
+  explicit group(const ctrl_t* ctrl) noexcept
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)))
+  {
+  }
+
+  group_mask match(ctrl_t h2) const noexcept
+  {
+    return mask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+  }
+
+  group_mask match_empty() const noexcept { return match(ctrl_empty); }
+
+  // The top bit is what sets empty and deleted apart from full
+  group_mask match_free() const noexcept { return mask(ctrl_); }
+
+  group_mask match_full() const noexcept
+  {
+    return group_mask(~bits(ctrl_) & 0xFFFFU);
+  }
+
+private:
+  __m128i ctrl_;
+
+  static std::uint32_t bits(__m128i bytes) noexcept
+  {
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(bytes));
+  }
+
+  static group_mask mask(__m128i bytes) noexcept
+  {
+    return group_mask(bits(bytes));
+  }
+#else
+  explicit group(const ctrl_t* ctrl) noexcept
+      : ctrl_(ctrl)
+  {
+  }
+
+  group_mask match(ctrl_t h2) const noexcept
+  {
+    return collect([h2](ctrl_t ctrl) { return ctrl == h2; });
+  }
+
+  group_mask match_empty() const noexcept { return match(ctrl_empty); }
+
+  group_mask match_free() const noexcept
+  {
+    return collect([](ctrl_t ctrl) { return ctrl < 0; });
+  }
+
+  group_mask match_full() const noexcept
+  {
+    return collect([](ctrl_t ctrl) { return ctrl >= 0; });
+  }
+
+private:
+  const ctrl_t* ctrl_;
+
+  template<typename Predicate>
+  group_mask collect(Predicate predicate) const noexcept
+  {
+    std::uint32_t bits = 0;
+    for (std::size_t i = 0; i < width; i++) {
+      if (predicate(ctrl_[i])) {
+        bits |= std::uint32_t {1} << i;
+      }
+    }
+    return group_mask(bits);
+  }
+#endif
+};
+
+// Table of Value, looked up by the Key that Policy::key extracts from a
+// Value. Policy::transfer move-constructs a Value into new storage when the
+// table grows, and Policy::constant_elements makes iterator a const one.
+// The capacity is zero or a power of two of at least group::width, and at
+// most 7/8 of it is filled before the table grows.
+template<typename Value,
+         typename Key,
+         typename Policy,
+         typename Hash,
+         typename KeyEqual>
+class hash_table
+{
+  // resize() can't put back a half-moved table, so moving has to succeed
+  static_assert(is_trivially_relocatable_v<Value>
+                    || noexcept(Policy::transfer(std::declval<Value*>(),
+                                                 std::declval<Value&>())),
+                "Flat hash containers need elements that move without "
+                "throwing");
+
+  template<bool Const>
+  class basic_iterator
+  {
+    using Slot = std::conditional_t<Const, const Value, Value>;
+
+    const ctrl_t* ctrl_ = nullptr;
+    const ctrl_t* end_ = nullptr;
+    Slot* slot_ = nullptr;
+
+    friend class hash_table;
+    friend class basic_iterator<!Const>;
+
+    basic_iterator(const ctrl_t* ctrl, const ctrl_t* end, Slot* slot) noexcept
+        : ctrl_(ctrl)
+        , end_(end)
+        , slot_(slot)
+    {
+    }
+
+    void skip_free() noexcept
+    {
+      while (ctrl_ != end_ && *ctrl_ < 0) {
+        ++ctrl_;
+        ++slot_;
+      }
+    }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_const_t<Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Slot*;
+    using reference = Slot&;
+
+    basic_iterator() noexcept = default;
+
+    // Mutable iterators convert to const ones
+    template<bool OtherConst>
+      requires(Const && !OtherConst)
+    basic_iterator(const basic_iterator<OtherConst>& other) noexcept
+        : ctrl_(other.ctrl_)
+        , end_(other.end_)
+        , slot_(other.slot_)
+    {
+    }
+
+    // Dereference operator
+    reference operator*() const { return *slot_; }
+
+    // Arrow operator
+    pointer operator->() const { return slot_; }
+
+    // Increment operators (pre-increment and post-increment)
+    basic_iterator& operator++() noexcept
+    {
+      ++ctrl_;
+      ++slot_;
+      skip_free();
+      return *this;
+    }
+
+    basic_iterator operator++(int) noexcept
+    {
+      basic_iterator temp = *this;
+      ++*this;
+      return temp;
+    }
+
+    // Comparison operators
+    friend bool operator==(const basic_iterator& lhs,
+                           const basic_iterator& rhs) noexcept
+    {
+      return lhs.ctrl_ == rhs.ctrl_;
+    }
+  };
+
+  static constexpr bool transparent = requires {
+    typename Hash::is_transparent;
+    typename KeyEqual::is_transparent;
+  };
+
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  vector<ctrl_t> ctrl_;
+  Value* slots_ = nullptr;
+  std::size_t size_ = 0;
+  // Empty slots that can still be filled before the table has to grow;
+  // deleted slots don't count, since reusing one isn't guaranteed
+  std::size_t growth_left_ = 0;
+  [[no_unique_address]] Hash hash_;
+  [[no_unique_address]] KeyEqual equal_;
+
+  // Spreads a weak hash such as std::hash's identity on integers over all
+  // the bits h1 and h2 are taken from
+  template<typename K>
+  std::size_t hash_of(const K& key) const
+  {
+    std::uint64_t mixed = std::uint64_t {hash_(key)} * 0x9E3779B97F4A7C15U;
+    return static_cast<std::size_t>(mixed ^ (mixed >> 32));
+  }
+
+  static ctrl_t h2(std::size_t hash) noexcept
+  {
+    return static_cast<ctrl_t>(hash & 0x7F);
+  }
+
+  static std::size_t max_filled(std::size_t capacity) noexcept
+  {
+    return capacity - capacity / 8;
+  }
+
+  // Smallest capacity holding count elements under the load factor
+  static std::size_t capacity_for(std::size_t count) noexcept
+  {
+    if (count == 0) {
+      return 0;
+    }
+    return std::bit_ceil(std::max(group::width, count + (count + 6) / 7));
+  }
+
+  // Visits the groups on hash's probe path in order until func, called
+  // with a group's first index and its control bytes, returns true
+  template<typename Func>
+  void probe(std::size_t hash, Func func) const
+  {
+    std::size_t groups_mask = capacity() / group::width - 1;
+    std::size_t index = (hash >> 7) & groups_mask;
+    for (std::size_t step = 1;; step++) {
+      std::size_t first = index * group::width;
+      if (func(first, group(ctrl_.data() + first))) {
+        return;
+      }
+      index = (index + step) & groups_mask;
+    }
+  }
+
+  template<typename K>
+  std::size_t find_index(const K& key, std::size_t hash) const
+  {
+    if (size_ == 0) {
+      return npos;
+    }
+    std::size_t found = npos;
+    probe(hash,
+          [&](std::size_t first, const group& ctrl)
+          {
+            for (auto match = ctrl.match(h2(hash)); match;
+                 match.clear_lowest())
+            {
+              std::size_t index = first + match.lowest();
+              if (equal_(Policy::key(slots_[index]), key)) {
+                found = index;
+                return true;
+              }
+            }
+            return static_cast<bool>(ctrl.match_empty());
+          });
+    return found;
+  }
+
+  // First empty or deleted slot on hash's probe path
+  std::size_t find_free(std::size_t hash) const
+  {
+    std::size_t found = npos;
+    probe(hash,
+          [&](std::size_t first, const group& ctrl)
+          {
+            auto match = ctrl.match_free();
+            if (match) {
+              found = first + match.lowest();
+            }
+            return found != npos;
+          });
+    return found;
+  }
+
+  // Moves every element into a fresh table of new_capacity, which also
+  // clears out the deleted slots
+  void resize(std::size_t new_capacity)
+  {
+    vector<ctrl_t> old_ctrl(new_capacity, ctrl_empty);
+    Value* old_slots = new_capacity == 0
+        ? nullptr
+        : allocator<Value>().allocate(new_capacity);
+    // The new buffers go in, and old_* now name the ones to empty
+    ctrl_.swap(old_ctrl);
+    std::swap(slots_, old_slots);
+    growth_left_ = max_filled(new_capacity) - size_;
+
+    std::size_t old_capacity = old_ctrl.size();
+    for (std::size_t i = 0; i < old_capacity; i++) {
+      if (old_ctrl[i] >= 0) {
+        Value& element = old_slots[i];
+        std::size_t hash = hash_of(Policy::key(element));
+        std::size_t index = find_free(hash);
+        ctrl_[index] = h2(hash);
+        relocate(slots_ + index, element);
+      }
+    }
+    if (old_slots != nullptr) {
+      allocator<Value>().deallocate(old_slots, old_capacity);
+    }
+  }
+
+  static void relocate(Value* dest, Value& source) noexcept
+  {
+    if constexpr (is_trivially_relocatable_v<Value>) {
+      std::memcpy(static_cast<void*>(dest), &source, sizeof(Value));
+    } else {
+      Policy::transfer(dest, source);
+      std::destroy_at(&source);
+    }
+  }
+
+  void destroy_all() noexcept
+  {
+    if constexpr (!std::is_trivially_destructible_v<Value>) {
+      for (std::size_t i = 0; i < capacity(); i++) {
+        if (ctrl_[i] >= 0) {
+          std::destroy_at(slots_ + i);
+        }
+      }
+    }
+  }
+
+  void release() noexcept
+  {
+    destroy_all();
+    if (slots_ != nullptr) {
+      allocator<Value>().deallocate(slots_, capacity());
+    }
+    ctrl_ = vector<ctrl_t>();
+    slots_ = nullptr;
+    size_ = 0;
+    growth_left_ = 0;
+  }
+
+  void erase_index(std::size_t index) noexcept
+  {
+    std::destroy_at(slots_ + index);
+    size_--;
+    // No probe has gone past a group that still has an empty slot, so the
+    // slot can go back to empty rather than leave a tombstone
+    std::size_t first = index & ~(group::width - 1);
+    if (group(ctrl_.data() + first).match_empty()) {
+      ctrl_[index] = ctrl_empty;
+      growth_left_++;
+    } else {
+      ctrl_[index] = ctrl_deleted;
+    }
+  }
+
+  template<typename Self, typename K>
+  static auto find_in(Self& self, const K& key)
+  {
+    std::size_t index = self.find_index(key, self.hash_of(key));
+    return index == npos ? self.end() : self.iterator_at(index);
+  }
+
+  template<typename K>
+  std::size_t erase_key(const K& key)
+  {
+    std::size_t index = find_index(key, hash_of(key));
+    if (index == npos) {
+      return 0;
+    }
+    erase_index(index);
+    return 1;
+  }
+
+public:
+  using key_type = Key;
+  using value_type = std::remove_const_t<Value>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  // Sets hand out only const iterators, since changing an element would
+  // change where it belongs
+  using iterator = basic_iterator<Policy::constant_elements>;
+  using const_iterator = basic_iterator<true>;
+
+  hash_table() = default;
+
+  hash_table(const hash_table& other)
+      : hash_(other.hash_)
+      , equal_(other.equal_)
+  {
+    reserve(other.size_);
+    try {
+      // other's keys are distinct, so each copy goes straight into the
+      // first free slot without comparing keys
+      for (const Value& element : other) {
+        std::size_t hash = hash_of(Policy::key(element));
+        std::size_t index = find_free(hash);
+        std::construct_at(slots_ + index, element);
+        ctrl_[index] = h2(hash);
+        growth_left_--;
+        size_++;
+      }
+    } catch (...) {
+      release();
+      throw;
+    }
+  }
+
+  hash_table(hash_table&& other) noexcept
+      : ctrl_(std::move(other.ctrl_))
+      , slots_(std::exchange(other.slots_, nullptr))
+      , size_(std::exchange(other.size_, 0))
+      , growth_left_(std::exchange(other.growth_left_, 0))
+      , hash_(std::move(other.hash_))
+      , equal_(std::move(other.equal_))
+  {
+  }
+
+  hash_table& operator=(const hash_table& other)
+  {
+    if (this != &other) {
+      hash_table copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  hash_table& operator=(hash_table&& other) noexcept
+  {
+    hash_table moved(std::move(other));
+    swap(moved);
+    return *this;
+  }
+
+  ~hash_table() { release(); }
+
+  iterator begin() noexcept
+  {
+    iterator it(ctrl_.data(), ctrl_.data() + capacity(), slots_);
+    it.skip_free();
+    return it;
+  }
+
+  iterator end() noexcept { return iterator_at(capacity()); }
+
+  const_iterator begin() const noexcept
+  {
+    const_iterator it(ctrl_.data(), ctrl_.data() + capacity(), slots_);
+    it.skip_free();
+    return it;
+  }
+
+  const_iterator end() const noexcept { return iterator_at(capacity()); }
+
+  std::size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  std::size_t capacity() const noexcept { return ctrl_.size(); }
+
+  float load_factor() const noexcept
+  {
+    return capacity() == 0
+        ? 0.0F
+        : static_cast<float>(size_) / static_cast<float>(capacity());
+  }
+
+  // Makes room for count elements in all, so inserting up to that many
+  // won't rehash
+  void reserve(std::size_t count)
+  {
+    if (count > size_ + growth_left_) {
+      resize(std::max(capacity_for(count), capacity()));
+    }
+  }
+
+  // Rebuilds the table at the smallest capacity holding both count and
+  // size() elements, which drops any tombstones; rehash(0) shrinks to fit
+  void rehash(std::size_t count)
+  {
+    resize(capacity_for(std::max(count, size_)));
+  }
+
+  void clear() noexcept
+  {
+    destroy_all();
+    simd::fill(ctrl_.data(), capacity(), ctrl_empty);
+    size_ = 0;
+    growth_left_ = max_filled(capacity());
+  }
+
+  iterator find(const Key& key) { return find_in(*this, key); }
+  const_iterator find(const Key& key) const { return find_in(*this, key); }
+
+  // Lookups take any key type when both Hash and KeyEqual are transparent
+  template<typename K>
+    requires transparent
+  iterator find(const K& key)
+  {
+    return find_in(*this, key);
+  }
+
+  template<typename K>
+    requires transparent
+  const_iterator find(const K& key) const
+  {
+    return find_in(*this, key);
+  }
+
+  bool contains(const Key& key) const { return find(key) != end(); }
+
+  template<typename K>
+    requires transparent
+  bool contains(const K& key) const
+  {
+    return find(key) != end();
+  }
+
+  std::size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+  template<typename K>
+    requires transparent
+  std::size_t count(const K& key) const
+  {
+    return contains(key) ? 1 : 0;
+  }
+
+  // Nothing moves, so only iterators to the erased element are invalidated
+  iterator erase(const_iterator it) noexcept
+  {
+    auto index = static_cast<std::size_t>(it.ctrl_ - ctrl_.data());
+    erase_index(index);
+    iterator next = iterator_at(index);
+    ++next;
+    return next;
+  }
+
+  std::size_t erase(const Key& key) { return erase_key(key); }
+
+  template<typename K>
+    requires(transparent && !std::is_convertible_v<K, iterator>
+             && !std::is_convertible_v<K, const_iterator>)
+  std::size_t erase(const K& key)
+  {
+    return erase_key(key);
+  }
+
+  void swap(hash_table& other) noexcept
+  {
+    ctrl_.swap(other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+  }
+
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return equal_; }
+
+  // Same elements, by key and then by value
+  friend bool operator==(const hash_table& lhs, const hash_table& rhs)
+  {
+    if (lhs.size_ != rhs.size_) {
+      return false;
+    }
+    for (const Value& element : lhs) {
+      auto it = rhs.find(Policy::key(element));
+      if (it == rhs.end() || !(*it == element)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+protected:
+  struct insert_slot
+  {
+    std::size_t index;
+    std::size_t hash;
+    bool inserted;
+  };
+
+  // Finds key, or else the free slot it would go in, growing the table if
+  // that slot can't be filled. The caller constructs the element there and
+  // then calls commit_insert.
+  template<typename K>
+  insert_slot find_or_prepare_insert(const K& key)
+  {
+    std::size_t hash = hash_of(key);
+    std::size_t index = find_index(key, hash);
+    if (index != npos) {
+      return {index, hash, false};
+    }
+    index = capacity() == 0 ? npos : find_free(hash);
+    if (index == npos || (growth_left_ == 0 && ctrl_[index] == ctrl_empty)) {
+      // Doubles, unless the load is mostly tombstones that a rebuild at the
+      // same capacity clears out
+      std::size_t needed = capacity_for(size_ + 1);
+      resize(needed > capacity() ? std::max(needed, capacity() * 2)
+                                 : capacity());
+      index = find_free(hash);
+    }
+    return {index, hash, true};
+  }
+
+  // Whether inserting a new element may have to grow the table, which
+  // moves every element. Callers whose arguments may refer into the table
+  // build the element first when it does.
+  bool insert_may_grow() const noexcept { return growth_left_ == 0; }
+
+  void commit_insert(const insert_slot& slot) noexcept
+  {
+    if (ctrl_[slot.index] == ctrl_empty) {
+      growth_left_--;
+    }
+    ctrl_[slot.index] = h2(slot.hash);
+    size_++;
+  }
+
+  Value* slot_at(std::size_t index) noexcept { return slots_ + index; }
+
+  iterator iterator_at(std::size_t index) noexcept
+  {
+    return {ctrl_.data() + index, ctrl_.data() + capacity(), slots_ + index};
+  }
+
+  const_iterator iterator_at(std::size_t index) const noexcept
+  {
+    return {ctrl_.data() + index, ctrl_.data() + capacity(), slots_ + index};
+  }
+
+  // Builds the element, then moves it in unless its key is already there
+  template<typename... Args>
+  std::pair<iterator, bool> emplace_value(Args&&... args)
+  {
+    Value value(std::forward<Args>(args)...);
+    insert_slot slot = find_or_prepare_insert(Policy::key(value));
+    if (slot.inserted) {
+      Policy::transfer(slots_ + slot.index, value);
+      commit_insert(slot);
+    }
+    return {iterator_at(slot.index), slot.inserted};
+  }
+};
+}  // namespace steev::detail
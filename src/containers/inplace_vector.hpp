@@ -0,0 +1,305 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "containers/array.hpp"
+#include "containers/pointer_iterator.hpp"
+
+namespace steev
+{
+namespace detail
+{
+// Trivial elements sit in a steev::array, which keeps every operation usable
+// during constant evaluation
+template<typename T,
+         std::size_t Capacity,
+         bool Trivial = std::is_trivially_default_constructible_v<T>
+             && std::is_trivially_copyable_v<T>>
+class inplace_storage
+{
+  steev::array<T, Capacity> elements_;
+
+public:
+  constexpr T* data() noexcept { return elements_.data(); }
+  constexpr const T* data() const noexcept { return elements_.data(); }
+};
+
+// Everything else gets raw bytes so no element is constructed up front
+template<typename T, std::size_t Capacity>
+class inplace_storage<T, Capacity, false>
+{
+  alignas(T) unsigned char bytes_[Capacity * sizeof(T)];
+
+public:
+  T* data() noexcept { return reinterpret_cast<T*>(bytes_); }
+  const T* data() const noexcept { return reinterpret_cast<const T*>(bytes_); }
+};
+}  // namespace detail
+
+// Vector with a fixed Capacity stored inside the object. It never allocates;
+// growing past Capacity throws std::length_error (or fails, for try_push_back)
+template<typename T, std::size_t Capacity>
+class inplace_vector
+{
+  using Iterator = pointer_iterator<T>;
+
+  static_assert(Capacity > 0, "inplace_vector needs room for an element");
+
+  std::size_t size_;
+  detail::inplace_storage<T, Capacity> storage_;
+
+  constexpr T* ptr() noexcept { return storage_.data(); }
+  constexpr const T* ptr() const noexcept { return storage_.data(); }
+
+  constexpr void check_room(std::size_t count) const
+  {
+    if (Capacity - size_ < count) {
+      throw std::length_error("inplace_vector capacity exceeded");
+    }
+  }
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = Iterator;
+
+  constexpr inplace_vector() noexcept
+      : size_(0)
+  {
+  }
+
+  constexpr inplace_vector(std::initializer_list<T> elements)
+      : inplace_vector()
+  {
+    check_room(elements.size());
+    for (const T& element : elements) {
+      std::construct_at(ptr() + size_, element);
+      ++size_;
+    }
+  }
+
+  constexpr explicit inplace_vector(std::size_t initial_size)
+      : inplace_vector()
+  {
+    resize(initial_size);
+  }
+
+  constexpr explicit inplace_vector(std::size_t initial_size,
+                                    const T& initial_element)
+      : inplace_vector()
+  {
+    assign(initial_size, initial_element);
+  }
+
+  constexpr inplace_vector(const inplace_vector& other)
+      : inplace_vector()
+  {
+    for (; size_ < other.size_; size_++) {
+      std::construct_at(ptr() + size_, other.ptr()[size_]);
+    }
+  }
+
+  constexpr inplace_vector(inplace_vector&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>)
+      : inplace_vector()
+  {
+    for (; size_ < other.size_; size_++) {
+      std::construct_at(ptr() + size_, std::move(other.ptr()[size_]));
+    }
+    other.clear();
+  }
+
+  constexpr inplace_vector& operator=(const inplace_vector& other)
+  {
+    if (this != &other) {
+      clear();
+      for (; size_ < other.size_; size_++) {
+        std::construct_at(ptr() + size_, other.ptr()[size_]);
+      }
+    }
+    return *this;
+  }
+
+  constexpr inplace_vector& operator=(inplace_vector&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>)
+  {
+    if (this != &other) {
+      clear();
+      for (; size_ < other.size_; size_++) {
+        std::construct_at(ptr() + size_, std::move(other.ptr()[size_]));
+      }
+      other.clear();
+    }
+    return *this;
+  }
+
+  constexpr ~inplace_vector()
+    requires std::is_trivially_destructible_v<T>
+  = default;
+
+  constexpr ~inplace_vector() { clear(); }
+
+  static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+  constexpr std::size_t size() const noexcept { return size_; }
+  constexpr bool empty() const noexcept { return size_ == 0; }
+  constexpr bool full() const noexcept { return size_ == Capacity; }
+
+  constexpr const T& operator[](std::size_t index) const
+  {
+    return ptr()[index];
+  }
+  constexpr T& operator[](std::size_t index) { return ptr()[index]; }
+
+  constexpr T& at(std::size_t idx)
+  {
+    if (idx >= size_) {
+      throw std::out_of_range("Index out of bounds");
+    }
+    return ptr()[idx];
+  }
+
+  constexpr T& front() { return ptr()[0]; }
+  constexpr T& back() { return ptr()[size_ - 1]; }
+
+  constexpr T* data() noexcept { return ptr(); }
+  constexpr const T* data() const noexcept { return ptr(); }
+
+  constexpr Iterator begin() noexcept { return ptr(); }
+  constexpr Iterator end() noexcept { return ptr() + size_; }
+
+  template<typename... Args>
+  constexpr T& emplace_back(Args&&... args)
+  {
+    check_room(1);
+    T* slot = std::construct_at(ptr() + size_, std::forward<Args>(args)...);
+    ++size_;
+    return *slot;
+  }
+
+  constexpr void push_back(const T& element) { emplace_back(element); }
+  constexpr void push_back(T&& element) { emplace_back(std::move(element)); }
+
+  // Appends without throwing when full; returns nullptr instead
+  template<typename... Args>
+  constexpr T* try_emplace_back(Args&&... args)
+  {
+    if (size_ == Capacity) {
+      return nullptr;
+    }
+    T* slot = std::construct_at(ptr() + size_, std::forward<Args>(args)...);
+    ++size_;
+    return slot;
+  }
+
+  constexpr T* try_push_back(const T& element)
+  {
+    return try_emplace_back(element);
+  }
+  constexpr T* try_push_back(T&& element)
+  {
+    return try_emplace_back(std::move(element));
+  }
+
+  constexpr void pop_back()
+  {
+    if (size_ == 0) {
+      throw std::runtime_error("Unable to pop vector with 0 elements");
+    }
+    size_--;
+    std::destroy_at(ptr() + size_);
+  }
+
+  constexpr Iterator insert(Iterator it, T&& element)
+  {
+    check_room(1);
+    auto index = static_cast<std::size_t>(it - begin());
+    T* data = ptr();
+
+    if (index == size_) {
+      std::construct_at(data + size_, std::move(element));
+    } else {
+      std::construct_at(data + size_, std::move(data[size_ - 1]));
+      std::move_backward(data + index, data + size_ - 1, data + size_);
+      data[index] = std::move(element);
+    }
+    ++size_;
+    return it;
+  }
+
+  constexpr Iterator erase(Iterator it)
+  {
+    std::move(it + 1, end(), it);
+    --size_;
+    std::destroy_at(ptr() + size_);
+    return it;
+  }
+
+  constexpr void resize(std::size_t new_size)
+  {
+    if (new_size < size_) {
+      std::destroy(ptr() + new_size, ptr() + size_);
+      size_ = new_size;
+      return;
+    }
+
+    check_room(new_size - size_);
+    for (; size_ < new_size; size_++) {
+      std::construct_at(ptr() + size_);
+    }
+  }
+
+  constexpr void assign(std::size_t size, const T& element)
+  {
+    clear();
+    check_room(size);
+    for (; size_ < size; size_++) {
+      std::construct_at(ptr() + size_, element);
+    }
+  }
+
+  constexpr void clear() noexcept
+  {
+    std::destroy(ptr(), ptr() + size_);
+    size_ = 0;
+  }
+
+  constexpr std::strong_ordering operator<=>(
+      const inplace_vector& other) const noexcept
+  {
+    if (size_ != other.size_) {
+      return size_ <=> other.size_;
+    }
+
+    for (std::size_t i = 0; i < size_; i++) {
+      if (ptr()[i] != other.ptr()[i]) {
+        return ptr()[i] <=> other.ptr()[i];
+      }
+    }
+
+    return std::strong_ordering::equal;
+  }
+
+  constexpr bool operator==(const inplace_vector& other) const noexcept
+  {
+    return *this <=> other == std::strong_ordering::equal;
+  }
+
+  constexpr void swap(inplace_vector& other)
+  {
+    inplace_vector tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+};
+}  // namespace steev
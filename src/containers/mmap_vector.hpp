@@ -0,0 +1,399 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "containers/growth_policy.hpp"
+#include "containers/pointer_iterator.hpp"
+
+namespace steev
+{
+// Access pattern hints passed on to madvise
+enum class mmap_advice
+{
+  normal,
+  sequential,
+  random,
+  will_need,
+  dont_need,
+};
+
+// Vector whose elements are the contents of a file mapped into memory, so
+// opening one costs nothing up front and pages are read in as they are
+// touched. Elements are stored as raw bytes, so T has to be trivially
+// copyable and the file is only portable between identical builds.
+//
+// mmap_vector<T> opens the file read-write, creating it if needed. The file
+// is grown with ftruncate and the mapping with mremap; the file is cut back
+// to size() when the vector is closed. Growing moves the mapping, which
+// invalidates iterators like a reallocation does. mmap_vector<const T> opens
+// the file read-only and has no members that change it. POSIX only.
+template<typename T, typename GrowthPolicy = doubling_growth>
+class mmap_vector
+{
+  static_assert(std::is_trivially_copyable_v<T>,
+                "mmap_vector stores elements as raw file bytes");
+
+  using Iterator = pointer_iterator<T>;
+  using ConstIterator = pointer_iterator<const T>;
+
+  static constexpr bool writable = !std::is_const_v<T>;
+
+  int fd_ = -1;
+  T* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t capacity_ = 0;
+  // Length of the mapping, which may run past the last whole element
+  std::size_t mapped_ = 0;
+
+  [[noreturn]] static void throw_errno(const char* call)
+  {
+    throw std::system_error(errno, std::generic_category(), call);
+  }
+
+  static std::size_t page_size() noexcept
+  {
+    static const auto size =
+        static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+  }
+
+  void require_open() const
+  {
+    if (fd_ == -1) {
+      throw std::logic_error("mmap_vector is not open for writing");
+    }
+  }
+
+  // The mapping's address as the system calls take it
+  void* address() const noexcept
+  {
+    return const_cast<std::remove_const_t<T>*>(data_);
+  }
+
+  void map(std::size_t bytes)
+  {
+    int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* address = ::mmap(nullptr, bytes, protection, MAP_SHARED, fd_, 0);
+    if (address == MAP_FAILED) {
+      throw_errno("mmap");
+    }
+    data_ = static_cast<T*>(address);
+    mapped_ = bytes;
+  }
+
+  void truncate(std::size_t bytes)
+  {
+    if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+      throw_errno("ftruncate");
+    }
+  }
+
+  void unmap() noexcept
+  {
+    if (data_ != nullptr) {
+      ::munmap(address(), mapped_);
+    }
+    data_ = nullptr;
+    mapped_ = 0;
+  }
+
+  // Resizes file and mapping to hold new_capacity elements, rounded up to
+  // whole pages
+  void remap(std::size_t new_capacity)
+  {
+    require_open();
+    std::size_t page = page_size();
+    std::size_t bytes = (new_capacity * sizeof(T) + page - 1) / page * page;
+    if (bytes == mapped_) {
+      return;
+    }
+
+    // The file has to cover the mapping before it grows, and may only
+    // shrink once the mapping has
+    bool growing = bytes > mapped_;
+    if (growing) {
+      truncate(bytes);
+    }
+    if (bytes == 0) {
+      unmap();
+    } else if (data_ == nullptr) {
+      map(bytes);
+    } else {
+#ifdef __linux__
+      void* moved = ::mremap(address(), mapped_, bytes, MREMAP_MAYMOVE);
+      if (moved == MAP_FAILED) {
+        throw_errno("mremap");
+      }
+      data_ = static_cast<T*>(moved);
+      mapped_ = bytes;
+#else
+      unmap();
+      map(bytes);
+#endif
+    }
+    if (!growing) {
+      truncate(bytes);
+    }
+    capacity_ = bytes / sizeof(T);
+  }
+
+  // Makes room for count more elements
+  void grow(std::size_t count = 1)
+  {
+    if (capacity_ - size_ < count) {
+      remap(GrowthPolicy::next_capacity(capacity_, size_ + count));
+    }
+  }
+
+public:
+  using value_type = std::remove_const_t<T>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  mmap_vector() noexcept = default;
+
+  // Maps the whole file, whose size has to be a multiple of sizeof(T)
+  explicit mmap_vector(const std::filesystem::path& path)
+  {
+    int flags = writable ? O_RDWR | O_CREAT : O_RDONLY;
+    fd_ = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+    if (fd_ == -1) {
+      throw_errno("open");
+    }
+
+    try {
+      struct stat status {};
+      if (::fstat(fd_, &status) != 0) {
+        throw_errno("fstat");
+      }
+      auto bytes = static_cast<std::size_t>(status.st_size);
+      if (bytes % sizeof(T) != 0) {
+        throw std::runtime_error(
+            "File size is not a multiple of the element size");
+      }
+      if (bytes != 0) {
+        map(bytes);
+      }
+      size_ = bytes / sizeof(T);
+      capacity_ = size_;
+    } catch (...) {
+      // Not close(), which would truncate the file to the empty size_
+      unmap();
+      ::close(fd_);
+      fd_ = -1;
+      throw;
+    }
+  }
+
+  mmap_vector(mmap_vector&& other) noexcept
+      : fd_(std::exchange(other.fd_, -1))
+      , data_(std::exchange(other.data_, nullptr))
+      , size_(std::exchange(other.size_, 0))
+      , capacity_(std::exchange(other.capacity_, 0))
+      , mapped_(std::exchange(other.mapped_, 0))
+  {
+  }
+
+  mmap_vector& operator=(mmap_vector&& other) noexcept
+  {
+    mmap_vector moved(std::move(other));
+    swap(moved);
+    return *this;
+  }
+
+  mmap_vector(const mmap_vector&) = delete;
+  mmap_vector& operator=(const mmap_vector&) = delete;
+
+  ~mmap_vector() { close(); }
+
+  // Unmaps the file and, if it was opened for writing, cuts it back to
+  // size() elements. The vector is left empty and closed.
+  void close() noexcept
+  {
+    unmap();
+    if (fd_ != -1) {
+      if constexpr (writable) {
+        static_cast<void>(
+            ::ftruncate(fd_, static_cast<off_t>(size_ * sizeof(T))));
+      }
+      ::close(fd_);
+    }
+    fd_ = -1;
+    size_ = 0;
+    capacity_ = 0;
+  }
+
+  bool is_open() const noexcept { return fd_ != -1; }
+
+  // Writes dirty pages back to the file before returning
+  void flush()
+  {
+    if (data_ != nullptr && ::msync(address(), mapped_, MS_SYNC) != 0) {
+      throw_errno("msync");
+    }
+  }
+
+  void advise(mmap_advice advice)
+  {
+    if (data_ == nullptr) {
+      return;
+    }
+    int flag = MADV_NORMAL;
+    switch (advice) {
+      case mmap_advice::normal:
+        flag = MADV_NORMAL;
+        break;
+      case mmap_advice::sequential:
+        flag = MADV_SEQUENTIAL;
+        break;
+      case mmap_advice::random:
+        flag = MADV_RANDOM;
+        break;
+      case mmap_advice::will_need:
+        flag = MADV_WILLNEED;
+        break;
+      case mmap_advice::dont_need:
+        flag = MADV_DONTNEED;
+        break;
+    }
+    if (::madvise(address(), mapped_, flag) != 0) {
+      throw_errno("madvise");
+    }
+  }
+
+  // For mmap_vector<const T> both overloads hand out const access only
+  Iterator begin() noexcept { return data_; }
+  Iterator end() noexcept { return data_ + size_; }
+  ConstIterator begin() const noexcept { return data_; }
+  ConstIterator end() const noexcept { return data_ + size_; }
+
+  T& operator[](std::size_t index) { return data_[index]; }
+  const T& operator[](std::size_t index) const { return data_[index]; }
+
+  T& at(std::size_t idx)
+  {
+    if (idx >= size_) {
+      throw std::out_of_range("Index out of bounds");
+    }
+    return data_[idx];
+  }
+
+  const T& at(std::size_t idx) const
+  {
+    if (idx >= size_) {
+      throw std::out_of_range("Index out of bounds");
+    }
+    return data_[idx];
+  }
+
+  T& front() { return data_[0]; }
+  const T& front() const { return data_[0]; }
+  T& back() { return data_[size_ - 1]; }
+  const T& back() const { return data_[size_ - 1]; }
+
+  T* data() noexcept { return data_; }
+  const T* data() const noexcept { return data_; }
+
+  std::size_t size() const noexcept { return size_; }
+  std::size_t capacity() const noexcept { return capacity_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  void reserve(std::size_t new_capacity)
+    requires writable
+  {
+    if (capacity_ < new_capacity) {
+      remap(new_capacity);
+    }
+  }
+
+  void shrink_to_fit()
+    requires writable
+  {
+    if (size_ < capacity_) {
+      remap(size_);
+    }
+  }
+
+  template<typename... Args>
+    requires writable
+  T& emplace_back(Args&&... args)
+  {
+    // args may refer into the mapping, which growing can move
+    T element(std::forward<Args>(args)...);
+    grow();
+    ::new (static_cast<void*>(data_ + size_)) T(element);
+    return data_[size_++];
+  }
+
+  void push_back(const T& element)
+    requires writable
+  {
+    emplace_back(element);
+  }
+
+  void pop_back()
+    requires writable
+  {
+    if (size_ == 0) {
+      throw std::runtime_error("Unable to pop vector with 0 elements");
+    }
+    require_open();
+    size_--;
+  }
+
+  void clear()
+    requires writable
+  {
+    require_open();
+    size_ = 0;
+  }
+
+  // New elements are value-initialized; the bytes past size() may hold
+  // earlier elements, so they get overwritten
+  void resize(std::size_t new_size)
+    requires writable
+  {
+    std::size_t old_size = size_;
+    resize_for_overwrite(new_size);
+    for (std::size_t i = old_size; i < new_size; i++) {
+      ::new (static_cast<void*>(data_ + i)) T();
+    }
+  }
+
+  // Leaves new elements holding whatever the file has at their position
+  void resize_for_overwrite(std::size_t new_size)
+    requires writable
+  {
+    require_open();
+    if (new_size > capacity_) {
+      grow(new_size - size_);
+    }
+    size_ = new_size;
+  }
+
+  void swap(mmap_vector& other) noexcept
+  {
+    std::swap(fd_, other.fd_);
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(mapped_, other.mapped_);
+  }
+};
+}  // namespace steev
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace steev
+{
+// Contiguous iterator over a single buffer, shared by the containers that
+// keep their elements in one
+template<typename T>
+class pointer_iterator
+{
+  T* ptr_;
+
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using iterator_concept = std::contiguous_iterator_tag;
+  using value_type = std::remove_cv_t<T>;
+  using element_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using reference = T&;
+
+  constexpr pointer_iterator() noexcept
+      : ptr_(nullptr)
+  {
+  }
+
+  constexpr pointer_iterator(T* ptr)
+      : ptr_(ptr)
+  {
+  }
+
+  // Dereference operator
+  constexpr reference operator*() const { return *ptr_; }
+
+  // Arrow operator
+  constexpr pointer operator->() const { return ptr_; }
+
+  // Subscript operator
+  constexpr reference operator[](difference_type index) const
+  {
+    return ptr_[index];
+  }
+
+  // Addition with a difference type
+  constexpr pointer_iterator operator+(difference_type incr) const
+  {
+    return pointer_iterator(ptr_ + incr);
+  }
+
+  friend constexpr pointer_iterator operator+(difference_type incr,
+                                             const pointer_iterator& it)
+  {
+    return it + incr;
+  }
+
+  // Subtraction with a difference type
+  constexpr pointer_iterator operator-(difference_type decr) const
+  {
+    return pointer_iterator(ptr_ - decr);
+  }
+
+  // Increment operators (pre-increment and post-increment)
+  constexpr pointer_iterator& operator++()
+  {
+    ++ptr_;
+    return *this;
+  }
+
+  constexpr pointer_iterator operator++(int)
+  {
+    pointer_iterator temp = *this;
+    ++ptr_;
+    return temp;
+  }
+
+  // Decrement operators (pre-decrement and post-decrement)
+  constexpr pointer_iterator& operator--()
+  {
+    --ptr_;
+    return *this;
+  }
+
+  constexpr pointer_iterator operator--(int)
+  {
+    pointer_iterator temp = *this;
+    --ptr_;
+    return temp;
+  }
+
+  // Difference between two iterators
+  constexpr difference_type operator-(const pointer_iterator& other) const
+  {
+    return ptr_ - other.ptr_;
+  }
+
+  // Compound assignment operators
+  constexpr pointer_iterator& operator+=(difference_type incr)
+  {
+    ptr_ += incr;
+    return *this;
+  }
+
+  constexpr pointer_iterator& operator-=(difference_type decr)
+  {
+    ptr_ -= decr;
+    return *this;
+  }
+
+  // Comparison operators
+  constexpr bool operator==(const pointer_iterator& other) const
+  {
+    return ptr_ == other.ptr_;
+  }
+
+  constexpr bool operator!=(const pointer_iterator& other) const
+  {
+    return ptr_ != other.ptr_;
+  }
+
+  constexpr bool operator<(const pointer_iterator& other) const
+  {
+    return ptr_ < other.ptr_;
+  }
+
+  constexpr bool operator<=(const pointer_iterator& other) const
+  {
+    return ptr_ <= other.ptr_;
+  }
+
+  constexpr bool operator>(const pointer_iterator& other) const
+  {
+    return ptr_ > other.ptr_;
+  }
+
+  constexpr bool operator>=(const pointer_iterator& other) const
+  {
+    return ptr_ >= other.ptr_;
+  }
+};
+}  // namespace steev
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "containers/array.hpp"
+#include "memory/aligned_allocator.hpp"
+
+namespace steev
+{
+namespace detail
+{
+// Raw storage for one queued element; the rings track which slots are live
+template<typename T>
+struct ring_storage
+{
+  alignas(T) std::byte bytes[sizeof(T)];
+
+  T* get() noexcept { return std::launder(reinterpret_cast<T*>(bytes)); }
+
+  template<typename... Args>
+  void construct(Args&&... args)
+  {
+    ::new (static_cast<void*>(bytes)) T(std::forward<Args>(args)...);
+  }
+
+  // Moves the element out and destroys it
+  template<typename OutputIt>
+  void take(OutputIt& out)
+  {
+    *out = std::move(*get());
+    ++out;
+    std::destroy_at(get());
+  }
+};
+}  // namespace detail
+
+// Bounded queue for exactly one producer and one consumer thread. Storage
+// is a steev::array of Capacity slots inside the object, so it never
+// allocates. head_ and tail_ count every pop and push since construction
+// and sit on separate cache lines, each next to the owning thread's cached
+// copy of the other index, so a thread only touches the other's line when
+// its cached copy says the ring is full or empty.
+template<typename T, std::size_t Capacity>
+class spsc_ring
+{
+  static_assert(std::has_single_bit(Capacity),
+                "Capacity has to be a power of two");
+
+  static constexpr std::size_t mask = Capacity - 1;
+
+  // Consumer side
+  alignas(cache_line_size) std::atomic<std::size_t> head_ = 0;
+  std::size_t cached_tail_ = 0;
+
+  // Producer side
+  alignas(cache_line_size) std::atomic<std::size_t> tail_ = 0;
+  std::size_t cached_head_ = 0;
+
+  alignas(cache_line_size) array<detail::ring_storage<T>, Capacity> slots_;
+
+  // Free slots as far as the producer knows, refreshing its copy of head_
+  // only when it needs more than it has
+  std::size_t free_slots(std::size_t tail, std::size_t wanted) noexcept
+  {
+    if (Capacity - (tail - cached_head_) < wanted) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+    }
+    return Capacity - (tail - cached_head_);
+  }
+
+  std::size_t ready_slots(std::size_t head, std::size_t wanted) noexcept
+  {
+    if (cached_tail_ - head < wanted) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+    }
+    return cached_tail_ - head;
+  }
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  spsc_ring() = default;
+
+  spsc_ring(const spsc_ring&) = delete;
+  spsc_ring& operator=(const spsc_ring&) = delete;
+
+  ~spsc_ring()
+  {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    for (std::size_t i = head_.load(std::memory_order_relaxed); i != tail; i++)
+    {
+      std::destroy_at(slots_[i & mask].get());
+    }
+  }
+
+  // Producer only. Returns false if the ring is full.
+  template<typename... Args>
+  bool try_emplace(Args&&... args)
+  {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (free_slots(tail, 1) == 0) {
+      return false;
+    }
+    slots_[tail & mask].construct(std::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_push(const T& element) { return try_emplace(element); }
+  bool try_push(T&& element) { return try_emplace(std::move(element)); }
+
+  // Producer only. Moves up to count elements in from first and publishes
+  // them all at once; returns how many fit.
+  template<std::input_iterator InputIt>
+  std::size_t push_batch(InputIt first, std::size_t count)
+  {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    std::size_t pushed = std::min(count, free_slots(tail, count));
+    std::size_t built = 0;
+    try {
+      for (; built < pushed; built++, ++first) {
+        slots_[(tail + built) & mask].construct(std::move(*first));
+      }
+    } catch (...) {
+      tail_.store(tail + built, std::memory_order_release);
+      throw;
+    }
+    if (pushed != 0) {
+      tail_.store(tail + pushed, std::memory_order_release);
+    }
+    return pushed;
+  }
+
+  // Consumer only. Returns false if the ring is empty.
+  bool try_pop(T& element)
+  {
+    return pop_batch(&element, 1) == 1;
+  }
+
+  // Consumer only. Moves up to max elements out to out and frees their
+  // slots at once; returns how many there were.
+  template<typename OutputIt>
+  std::size_t pop_batch(OutputIt out, std::size_t max)
+  {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    std::size_t popped = std::min(max, ready_slots(head, max));
+    std::size_t taken = 0;
+    try {
+      for (; taken < popped; taken++) {
+        slots_[(head + taken) & mask].take(out);
+      }
+    } catch (...) {
+      head_.store(head + taken, std::memory_order_release);
+      throw;
+    }
+    if (popped != 0) {
+      head_.store(head + popped, std::memory_order_release);
+    }
+    return popped;
+  }
+
+  // Exact only while neither side is running
+  std::size_t size() const noexcept
+  {
+    std::size_t head = head_.load(std::memory_order_acquire);
+    return tail_.load(std::memory_order_acquire) - head;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+  static constexpr std::size_t capacity() noexcept { return Capacity; }
+};
+
+// Bounded queue for any number of producer and consumer threads, after
+// Dmitry Vyukov's design. Each slot carries a sequence number saying whose
+// turn it is: slot i is free for the push at position p when its sequence
+// is p and holds the element for the pop at p when it is p + 1. Producers
+// and consumers claim positions by advancing tail_ and head_ with a
+// compare-exchange and then only touch their own slots, so a batch of n
+// costs one compare-exchange rather than n.
+template<typename T, std::size_t Capacity>
+class mpmc_ring
+{
+  static_assert(std::has_single_bit(Capacity),
+                "Capacity has to be a power of two");
+
+  static constexpr std::size_t mask = Capacity - 1;
+
+  struct slot : detail::ring_storage<T>
+  {
+    std::atomic<std::size_t> sequence;
+  };
+
+  alignas(cache_line_size) std::atomic<std::size_t> head_ = 0;
+  alignas(cache_line_size) std::atomic<std::size_t> tail_ = 0;
+  alignas(cache_line_size) array<slot, Capacity> slots_;
+
+  // Counts the slots from position on, up to max, whose sequence is
+  // position + offset, i.e. that are ready for the claimer
+  std::size_t ready_run(std::size_t position,
+                        std::size_t max,
+                        std::size_t offset) const noexcept
+  {
+    std::size_t run = 0;
+    while (run < max
+           && slots_[(position + run) & mask].sequence.load(
+                  std::memory_order_acquire)
+               == position + run + offset)
+    {
+      run++;
+    }
+    return run;
+  }
+
+  // Claims up to max consecutive positions from index; returns the first
+  // and how many. A slot that isn't ready yet ends the run, and the run is
+  // checked again if another thread moves index first.
+  std::pair<std::size_t, std::size_t> claim(std::atomic<std::size_t>& index,
+                                            std::size_t max,
+                                            std::size_t offset) noexcept
+  {
+    std::size_t position = index.load(std::memory_order_relaxed);
+    while (true) {
+      std::size_t run = ready_run(position, max, offset);
+      if (run == 0) {
+        // Either full/empty, or another thread is mid-claim on position
+        std::size_t current = index.load(std::memory_order_relaxed);
+        if (current == position) {
+          return {position, 0};
+        }
+        position = current;
+      } else if (index.compare_exchange_weak(position,
+                                             position + run,
+                                             std::memory_order_relaxed))
+      {
+        return {position, run};
+      }
+    }
+  }
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  mpmc_ring() noexcept
+  {
+    for (std::size_t i = 0; i < Capacity; i++) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  mpmc_ring(const mpmc_ring&) = delete;
+  mpmc_ring& operator=(const mpmc_ring&) = delete;
+
+  ~mpmc_ring()
+  {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    for (std::size_t i = head_.load(std::memory_order_relaxed); i != tail; i++)
+    {
+      std::destroy_at(slots_[i & mask].get());
+    }
+  }
+
+  // Returns false if the ring is full. A claimed slot has to be filled, so
+  // constructing or moving T must not throw; if it does, that terminates.
+  template<typename... Args>
+  bool try_emplace(Args&&... args) noexcept
+  {
+    auto [position, claimed] = claim(tail_, 1, 0);
+    if (claimed == 0) {
+      return false;
+    }
+    slot& target = slots_[position & mask];
+    target.construct(std::forward<Args>(args)...);
+    target.sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_push(const T& element) noexcept { return try_emplace(element); }
+  bool try_push(T&& element) noexcept
+  {
+    return try_emplace(std::move(element));
+  }
+
+  // Moves up to count elements in from first; returns how many fit
+  template<std::input_iterator InputIt>
+  std::size_t push_batch(InputIt first, std::size_t count) noexcept
+  {
+    auto [position, claimed] = claim(tail_, count, 0);
+    for (std::size_t i = 0; i < claimed; i++, ++first) {
+      slot& target = slots_[(position + i) & mask];
+      target.construct(std::move(*first));
+      target.sequence.store(position + i + 1, std::memory_order_release);
+    }
+    return claimed;
+  }
+
+  // Returns false if the ring is empty
+  bool try_pop(T& element) noexcept { return pop_batch(&element, 1) == 1; }
+
+  // Moves up to max elements out to out; returns how many there were
+  template<typename OutputIt>
+  std::size_t pop_batch(OutputIt out, std::size_t max) noexcept
+  {
+    auto [position, claimed] = claim(head_, max, 1);
+    for (std::size_t i = 0; i < claimed; i++) {
+      slot& source = slots_[(position + i) & mask];
+      source.take(out);
+      source.sequence.store(position + i + Capacity,
+                            std::memory_order_release);
+    }
+    return claimed;
+  }
+
+  // Approximate while other threads are pushing or popping
+  std::size_t size() const noexcept
+  {
+    std::size_t head = head_.load(std::memory_order_acquire);
+    std::size_t tail = tail_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+  static constexpr std::size_t capacity() noexcept { return Capacity; }
+};
+}  // namespace steev
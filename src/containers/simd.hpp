@@ -0,0 +1,537 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#  include <immintrin.h>
+#  define STEEV_SIMD_X86
+#  define STEEV_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// Comparison, search and fill kernels shared by steev::vector and
+// steev::array. Arithmetic element types are handled 16 or 32 bytes at a
+// time with SSE2, or AVX2 when the CPU has it, on x86-64 builds from GCC or
+// Clang. Every other type and target, and constant evaluation, takes the
+// plain loops. Both give the same answers, NaNs and signed zeros included.
+
+namespace steev::simd
+{
+enum class isa
+{
+  scalar,
+  sse2,
+  avx2,
+};
+
+// Element types the vector kernels handle
+template<typename T>
+inline constexpr bool vectorizable =
+    (std::is_integral_v<T>
+     && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4
+         || sizeof(T) == 8))
+    || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+// Best instruction set this CPU supports; checked once
+inline isa detected_isa() noexcept
+{
+#ifdef STEEV_SIMD_X86
+  static const isa level = []
+  {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? isa::avx2 : isa::sse2;
+  }();
+  return level;
+#else
+  return isa::scalar;
+#endif
+}
+
+namespace detail
+{
+template<typename T>
+constexpr bool same_value(const T& lhs, const T& rhs)
+{
+  if constexpr (std::is_floating_point_v<T>) {
+    // Exactly ==, spelled so -Wfloat-equal stays quiet
+    return lhs <= rhs && lhs >= rhs;
+  } else {
+    return lhs == rhs;
+  }
+}
+
+// Also finish off the tails the vector loops leave
+namespace scalar
+{
+template<typename T>
+constexpr std::size_t mismatch(const T* lhs, const T* rhs, std::size_t count)
+{
+  std::size_t index = 0;
+  for (; index < count; index++) {
+    if (!same_value(lhs[index], rhs[index])) {
+      break;
+    }
+  }
+  return index;
+}
+
+template<typename T>
+constexpr std::size_t find(const T* data, std::size_t count, const T& value)
+{
+  std::size_t index = 0;
+  for (; index < count; index++) {
+    if (same_value(data[index], value)) {
+      break;
+    }
+  }
+  return index;
+}
+
+template<typename T>
+constexpr std::size_t count(const T* data, std::size_t count, const T& value)
+{
+  std::size_t matches = 0;
+  for (std::size_t index = 0; index < count; index++) {
+    if (same_value(data[index], value)) {
+      matches++;
+    }
+  }
+  return matches;
+}
+
+template<typename T>
+constexpr void fill(T* data, std::size_t count, const T& value)
+{
+  for (std::size_t index = 0; index < count; index++) {
+    data[index] = value;
+  }
+}
+}  // namespace scalar
+
+#ifdef STEEV_SIMD_X86
+// Integers are broadcast through the signed type of the same width
+template<std::size_t Size>
+using lane_int = std::conditional_t<
+    Size == 1,
+    std::int8_t,
+    std::conditional_t<
+        Size == 2,
+        std::int16_t,
+        std::conditional_t<Size == 4, std::int32_t, std::int64_t>>>;
+
+// The compares yield one bit per byte, set in every byte of each lane that
+// matched, so a lane index is a bit index divided by sizeof(T)
+template<typename T>
+constexpr std::size_t lane(int bit) noexcept
+{
+  return static_cast<std::size_t>(bit) / sizeof(T);
+}
+
+namespace sse2
+{
+constexpr std::size_t width = 16;
+
+inline __m128i load(const void* ptr) noexcept
+{
+  return _mm_loadu_si128(static_cast<const __m128i*>(ptr));
+}
+
+template<typename T>
+__m128i broadcast(T value) noexcept
+{
+  if constexpr (std::is_same_v<T, float>) {
+    return _mm_castps_si128(_mm_set1_ps(value));
+  } else if constexpr (std::is_same_v<T, double>) {
+    return _mm_castpd_si128(_mm_set1_pd(value));
+  } else if constexpr (sizeof(T) == 1) {
+    return _mm_set1_epi8(std::bit_cast<lane_int<1>>(value));
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm_set1_epi16(std::bit_cast<lane_int<2>>(value));
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm_set1_epi32(std::bit_cast<lane_int<4>>(value));
+  } else {
+    return _mm_set1_epi64x(std::bit_cast<lane_int<8>>(value));
+  }
+}
+
+template<typename T>
+std::uint32_t equal_mask(__m128i lhs, __m128i rhs) noexcept
+{
+  __m128i equal;
+  if constexpr (std::is_same_v<T, float>) {
+    equal = _mm_castps_si128(
+        _mm_cmpeq_ps(_mm_castsi128_ps(lhs), _mm_castsi128_ps(rhs)));
+  } else if constexpr (std::is_same_v<T, double>) {
+    equal = _mm_castpd_si128(
+        _mm_cmpeq_pd(_mm_castsi128_pd(lhs), _mm_castsi128_pd(rhs)));
+  } else if constexpr (sizeof(T) == 1) {
+    equal = _mm_cmpeq_epi8(lhs, rhs);
+  } else if constexpr (sizeof(T) == 2) {
+    equal = _mm_cmpeq_epi16(lhs, rhs);
+  } else if constexpr (sizeof(T) == 4) {
+    equal = _mm_cmpeq_epi32(lhs, rhs);
+  } else {
+    // No 64-bit compare before SSE4.1: both halves have to match
+    __m128i halves = _mm_cmpeq_epi32(lhs, rhs);
+    equal = _mm_and_si128(halves, _mm_shuffle_epi32(halves, 0xB1));
+  }
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(equal));
+}
+
+template<typename T>
+std::size_t mismatch(const T* lhs, const T* rhs, std::size_t count) noexcept
+{
+  constexpr std::size_t lanes = width / sizeof(T);
+  std::size_t body = count - count % lanes;
+  for (std::size_t index = 0; index != body; index += lanes) {
+    std::uint32_t equal =
+        equal_mask<T>(load(lhs + index), load(rhs + index));
+    if (equal != 0xFFFF) {
+      return index + lane<T>(std::countr_one(equal));
+    }
+  }
+  return body + scalar::mismatch(lhs + body, rhs + body, count - body);
+}
+
+template<typename T>
+std::size_t find(const T* data, std::size_t count, T value) noexcept
+{
+  constexpr std::size_t lanes = width / sizeof(T);
+  __m128i needle = broadcast(value);
+  std::size_t body = count - count % lanes;
+  for (std::size_t index = 0; index != body; index += lanes) {
+    std::uint32_t equal = equal_mask<T>(load(data + index), needle);
+    if (equal != 0) {
+      return index + lane<T>(std::countr_zero(equal));
+    }
+  }
+  return body + scalar::find(data + body, count - body, value);
+}
+
+template<typename T>
+std::size_t count(const T* data, std::size_t count, T value) noexcept
+{
+  constexpr std::size_t lanes = width / sizeof(T);
+  __m128i needle = broadcast(value);
+  std::size_t body = count - count % lanes;
+  std::size_t matches = 0;
+  for (std::size_t index = 0; index != body; index += lanes) {
+    matches += lane<T>(
+        std::popcount(equal_mask<T>(load(data + index), needle)));
+  }
+  return matches + scalar::count(data + body, count - body, value);
+}
+
+template<typename T>
+void fill(T* data, std::size_t count, T value) noexcept
+{
+  constexpr std::size_t lanes = width / sizeof(T);
+  __m128i pattern = broadcast(value);
+  std::size_t body = count - count % lanes;
+  for (std::size_t index = 0; index != body; index += lanes) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data + index), pattern);
+  }
+  scalar::fill(data + body, count - body, value);
+}
+}  // namespace sse2
+
+namespace avx2
+{
+constexpr std::size_t width = 32;
+
+STEEV_TARGET_AVX2 inline __m256i load(const void* ptr) noexcept
+{
+  return _mm256_loadu_si256(static_cast<const __m256i*>(ptr));
+}
+
+template<typename T>
+STEEV_TARGET_AVX2 __m256i broadcast(T value) noexcept
+{
+  if constexpr (std::is_same_v<T, float>) {
+    return _mm256_castps_si256(_mm256_set1_ps(value));
+  } else if constexpr (std::is_same_v<T, double>) {
+    return _mm256_castpd_si256(_mm256_set1_pd(value));
+  } else if constexpr (sizeof(T) == 1) {
+    return _mm256_set1_epi8(std::bit_cast<lane_int<1>>(value));
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm256_set1_epi16(std::bit_cast<lane_int<2>>(value));
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm256_set1_epi32(std::bit_cast<lane_int<4>>(value));
+  } else {
+    return _mm256_set1_epi64x(std::bit_cast<lane_int<8>>(value));
+  }
+}
+
+// All ones in every lane that matched
+template<typename T>
+STEEV_TARGET_AVX2 __m256i equal_lanes(__m256i lhs, __m256i rhs) noexcept
+{
+  if constexpr (std::is_same_v<T, float>) {
+    return _mm256_castps_si256(_mm256_cmp_ps(
+        _mm256_castsi256_ps(lhs), _mm256_castsi256_ps(rhs), _CMP_EQ_OQ));
+  } else if constexpr (std::is_same_v<T, double>) {
+    return _mm256_castpd_si256(_mm256_cmp_pd(
+        _mm256_castsi256_pd(lhs), _mm256_castsi256_pd(rhs), _CMP_EQ_OQ));
+  } else if constexpr (sizeof(T) == 1) {
+    return _mm256_cmpeq_epi8(lhs, rhs);
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm256_cmpeq_epi16(lhs, rhs);
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm256_cmpeq_epi32(lhs, rhs);
+  } else {
+    return _mm256_cmpeq_epi64(lhs, rhs);
+  }
+}
+
+STEEV_TARGET_AVX2 inline std::uint32_t byte_mask(__m256i lanes) noexcept
+{
+  return static_cast<std::uint32_t>(_mm256_movemask_epi8(lanes));
+}
+
+template<typename T>
+STEEV_TARGET_AVX2 std::uint32_t equal_mask(__m256i lhs, __m256i rhs) noexcept
+{
+  return byte_mask(equal_lanes<T>(lhs, rhs));
+}
+
+// Whether four consecutive blocks all match
+template<typename T>
+STEEV_TARGET_AVX2 bool equal_blocks(const T* lhs, const T* rhs) noexcept
+{
+  constexpr std::size_t lanes = width / sizeof(T);
+  __m256i first = _mm256_and_si256(
+      equal_lanes<T>(load(lhs), load(rhs)),
+      equal_lanes<T>(load(lhs + lanes), load(rhs + lanes)));
+  __m256i second = _mm256_and_si256(
+      equal_lanes<T>(load(lhs + 2 * lanes), load(rhs + 2 * lanes)),
+      equal_lanes<T>(load(lhs + 3 * lanes), load(rhs + 3 * lanes)));
+  return byte_mask(_mm256_and_si256(first, second)) == 0xFFFFFFFF;
+}
+
+template<typename T>
+STEEV_TARGET_AVX2 std::size_t mismatch(const T* lhs,
+                                       const T* rhs,
+                                       std::size_t count) noexcept
+{
+  constexpr std::size_t lanes = width / sizeof(T);
+  std::size_t body = count - count % lanes;
+  // Skip ahead four blocks at a time, then find the block that differs
+  std::size_t unrolled = count - count % (4 * lanes);
+  std::size_t index = 0;
+  while (index != unrolled && equal_blocks(lhs + index, rhs + index)) {
+    index += 4 * lanes;
+  }
+  for (; index != body; index += lanes) {
+    std::uint32_t equal =
+        equal_mask<T>(load(lhs + index), load(rhs + index));
+    if (equal != 0xFFFFFFFF) {
+      return index + lane<T>(std::countr_one(equal));
+    }
+  }
+  return body + scalar::mismatch(lhs + body, rhs + body, count - body);
+}
+
+template<typename T>
+STEEV_TARGET_AVX2 std::size_t find(const T* data,
+                                   std::size_t count,
+                                   T value) noexcept
+{
+  constexpr std::size_t lanes = width / sizeof(T);
+  __m256i needle = broadcast(value);
+  std::size_t body = count - count % lanes;
+  for (std::size_t index = 0; index != body; index += lanes) {
+    std::uint32_t equal = equal_mask<T>(load(data + index), needle);
+    if (equal != 0) {
+      return index + lane<T>(std::countr_zero(equal));
+    }
+  }
+  return body + scalar::find(data + body, count - body, value);
+}
+
+template<typename T>
+STEEV_TARGET_AVX2 std::size_t count(const T* data,
+                                    std::size_t count,
+                                    T value) noexcept
+{
+  constexpr std::size_t lanes = width / sizeof(T);
+  __m256i needle = broadcast(value);
+  std::size_t body = count - count % lanes;
+  std::size_t matches = 0;
+  for (std::size_t index = 0; index != body; index += lanes) {
+    matches += lane<T>(
+        std::popcount(equal_mask<T>(load(data + index), needle)));
+  }
+  return matches + scalar::count(data + body, count - body, value);
+}
+
+template<typename T>
+STEEV_TARGET_AVX2 void fill(T* data, std::size_t count, T value) noexcept
+{
+  constexpr std::size_t lanes = width / sizeof(T);
+  __m256i pattern = broadcast(value);
+  std::size_t body = count - count % lanes;
+  for (std::size_t index = 0; index != body; index += lanes) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + index), pattern);
+  }
+  scalar::fill(data + body, count - body, value);
+}
+}  // namespace avx2
+#endif
+}  // namespace detail
+
+// Each kernel comes in two forms: one that runs on detected_isa(), and one
+// that is pinned to a given level, which must not exceed detected_isa().
+// The pinned ones exist for tests and benchmarks.
+
+// Index of the first position where lhs and rhs differ, or count
+template<typename T>
+constexpr std::size_t mismatch(const T* lhs,
+                               const T* rhs,
+                               std::size_t count,
+                               [[maybe_unused]] isa level)
+{
+  if !consteval {
+#ifdef STEEV_SIMD_X86
+    if constexpr (vectorizable<T>) {
+      switch (level) {
+        case isa::avx2:
+          return detail::avx2::mismatch(lhs, rhs, count);
+        case isa::sse2:
+          return detail::sse2::mismatch(lhs, rhs, count);
+        case isa::scalar:
+          break;
+      }
+    }
+#endif
+  }
+  return detail::scalar::mismatch(lhs, rhs, count);
+}
+
+template<typename T>
+constexpr std::size_t mismatch(const T* lhs, const T* rhs, std::size_t count)
+{
+  if !consteval {
+    if constexpr (vectorizable<T>) {
+      return simd::mismatch(lhs, rhs, count, detected_isa());
+    }
+  }
+  return detail::scalar::mismatch(lhs, rhs, count);
+}
+
+template<typename T>
+constexpr bool equal(const T* lhs, const T* rhs, std::size_t count)
+{
+  return simd::mismatch(lhs, rhs, count) == count;
+}
+
+// Index of the first element equal to value, or count
+template<typename T>
+constexpr std::size_t find(const T* data,
+                           std::size_t count,
+                           const T& value,
+                           [[maybe_unused]] isa level)
+{
+  if !consteval {
+#ifdef STEEV_SIMD_X86
+    if constexpr (vectorizable<T>) {
+      switch (level) {
+        case isa::avx2:
+          return detail::avx2::find(data, count, value);
+        case isa::sse2:
+          return detail::sse2::find(data, count, value);
+        case isa::scalar:
+          break;
+      }
+    }
+#endif
+  }
+  return detail::scalar::find(data, count, value);
+}
+
+template<typename T>
+constexpr std::size_t find(const T* data, std::size_t count, const T& value)
+{
+  if !consteval {
+    if constexpr (vectorizable<T>) {
+      return simd::find(data, count, value, detected_isa());
+    }
+  }
+  return detail::scalar::find(data, count, value);
+}
+
+// Number of elements equal to value
+template<typename T>
+constexpr std::size_t count(const T* data,
+                            std::size_t count,
+                            const T& value,
+                            [[maybe_unused]] isa level)
+{
+  if !consteval {
+#ifdef STEEV_SIMD_X86
+    if constexpr (vectorizable<T>) {
+      switch (level) {
+        case isa::avx2:
+          return detail::avx2::count(data, count, value);
+        case isa::sse2:
+          return detail::sse2::count(data, count, value);
+        case isa::scalar:
+          break;
+      }
+    }
+#endif
+  }
+  return detail::scalar::count(data, count, value);
+}
+
+template<typename T>
+constexpr std::size_t count(const T* data, std::size_t count, const T& value)
+{
+  if !consteval {
+    if constexpr (vectorizable<T>) {
+      return simd::count(data, count, value, detected_isa());
+    }
+  }
+  return detail::scalar::count(data, count, value);
+}
+
+// Assigns value to count elements, which must already be alive unless T is
+// implicit-lifetime (every vectorizable type is)
+template<typename T>
+constexpr void fill(T* data,
+                    std::size_t count,
+                    const T& value,
+                    [[maybe_unused]] isa level)
+{
+  if !consteval {
+#ifdef STEEV_SIMD_X86
+    if constexpr (vectorizable<T>) {
+      switch (level) {
+        case isa::avx2:
+          detail::avx2::fill(data, count, value);
+          return;
+        case isa::sse2:
+          detail::sse2::fill(data, count, value);
+          return;
+        case isa::scalar:
+          break;
+      }
+    }
+#endif
+  }
+  detail::scalar::fill(data, count, value);
+}
+
+template<typename T>
+constexpr void fill(T* data, std::size_t count, const T& value)
+{
+  if !consteval {
+    if constexpr (vectorizable<T>) {
+      simd::fill(data, count, value, detected_isa());
+      return;
+    }
+  }
+  detail::scalar::fill(data, count, value);
+}
+}  // namespace steev::simd
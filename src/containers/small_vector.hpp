@@ -0,0 +1,560 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "containers/pointer_iterator.hpp"
+#include "memory/allocator.hpp"
+#include "memory/allocator_traits.hpp"
+#include "memory/instrumentation.hpp"
+#include "memory/relocate.hpp"
+
+namespace steev
+{
+// Same interface as steev::vector, but the first InlineCapacity elements live
+// inside the object itself; the allocator is only used once it outgrows them.
+// Unlike steev::vector it has no GrowthPolicy; the heap buffer doubles.
+template<typename T,
+         std::size_t InlineCapacity,
+         typename Allocator = steev::allocator<T>>
+class small_vector
+{
+  using Iterator = pointer_iterator<T>;
+  using alloc_traits = allocator_traits<Allocator>;
+
+  static_assert(InlineCapacity > 0,
+                "Use steev::vector when no inline storage is wanted");
+  static_assert(std::is_same_v<typename alloc_traits::value_type, T>,
+                "Allocator::value_type must match the vector's value type");
+  static_assert(std::is_same_v<typename alloc_traits::pointer, T*>,
+                "Only allocators handing out raw pointers are supported");
+
+  static constexpr bool bitwise_relocatable = is_trivially_relocatable_v<T>
+      && alloc_traits::template uses_default_construct<T>;
+
+  std::size_t size_;
+  std::size_t capacity_;
+  T* data_;
+  [[no_unique_address]] Allocator alloc_;
+  alignas(T) unsigned char inline_storage_[InlineCapacity * sizeof(T)];
+
+  T* inline_data() noexcept { return reinterpret_cast<T*>(inline_storage_); }
+
+  const T* inline_data() const noexcept
+  {
+    return reinterpret_cast<const T*>(inline_storage_);
+  }
+
+  T* allocate(std::size_t count)
+  {
+    T* ptr = alloc_traits::allocate(alloc_, count);
+    instrumentation::on_allocate<small_vector>(count * sizeof(T));
+    return ptr;
+  }
+
+  void deallocate(T* ptr, std::size_t count) noexcept
+  {
+    alloc_traits::deallocate(alloc_, ptr, count);
+    instrumentation::on_deallocate<small_vector>();
+  }
+
+  void destroy(T* first, T* last) noexcept
+  {
+    for (; first != last; ++first) {
+      alloc_traits::destroy(alloc_, first);
+    }
+  }
+
+  // Relocates [first, last) into uninitialized, non-overlapping storage
+  void relocate(T* first, T* last, T* dest)
+  {
+    if constexpr (bitwise_relocatable) {
+      uninitialized_relocate(first, last, dest);
+    } else {
+      T* out = dest;
+      try {
+        for (T* it = first; it != last; ++it, ++out) {
+          alloc_traits::construct(alloc_, out, std::move_if_noexcept(*it));
+        }
+      } catch (...) {
+        destroy(dest, out);
+        throw;
+      }
+      destroy(first, last);
+    }
+  }
+
+  // Moves the elements into a buffer of new_capacity >= size_ elements,
+  // going back to the inline storage whenever they fit there
+  void reallocate(std::size_t new_capacity)
+  {
+    if (new_capacity <= InlineCapacity) {
+      if (!is_inline()) {
+        instrumentation::on_reallocate<small_vector>();
+        T* heap = data_;
+        relocate(heap, heap + size_, inline_data());
+        deallocate(heap, capacity_);
+        data_ = inline_data();
+        capacity_ = InlineCapacity;
+      }
+      return;
+    }
+
+    instrumentation::on_reallocate<small_vector>();
+    if constexpr (bitwise_relocatable && alloc_traits::has_reallocate) {
+      if (!is_inline()) {
+        data_ =
+            alloc_traits::reallocate(alloc_, data_, capacity_, new_capacity);
+        instrumentation::on_deallocate<small_vector>();
+        instrumentation::on_allocate<small_vector>(new_capacity * sizeof(T));
+        capacity_ = new_capacity;
+        return;
+      }
+    }
+
+    T* new_data = allocate(new_capacity);
+    try {
+      relocate(data_, data_ + size_, new_data);
+    } catch (...) {
+      deallocate(new_data, new_capacity);
+      throw;
+    }
+    if (!is_inline()) {
+      deallocate(data_, capacity_);
+    }
+
+    data_ = new_data;
+    capacity_ = new_capacity;
+  }
+
+  // Makes room for count more elements
+  void grow(std::size_t count = 1)
+  {
+    if (capacity_ - size_ < count) {
+      reallocate(std::max(capacity_ * 2, size_ + count));
+    }
+  }
+
+  // element must not refer into this vector, which may reallocate
+  void insert_at(std::size_t index, T&& element)
+  {
+    if (index == size_) {
+      emplace_back(std::move(element));
+      return;
+    }
+    grow();
+
+    if constexpr (bitwise_relocatable) {
+      T* hole = data_ + index;
+      std::memmove(static_cast<void*>(hole + 1),
+                   static_cast<const void*>(hole),
+                   (size_ - index) * sizeof(T));
+      try {
+        alloc_traits::construct(alloc_, hole, std::move(element));
+      } catch (...) {
+        std::memmove(static_cast<void*>(hole),
+                     static_cast<const void*>(hole + 1),
+                     (size_ - index) * sizeof(T));
+        throw;
+      }
+    } else {
+      alloc_traits::construct(
+          alloc_, data_ + size_, std::move(data_[size_ - 1]));
+      std::move_backward(data_ + index, data_ + size_ - 1, data_ + size_);
+      data_[index] = std::move(element);
+    }
+    ++size_;
+  }
+
+  // Appends [first, last), then rotates it into place at index
+  template<typename It, typename Sentinel>
+  void insert_rotate(std::size_t index, It first, Sentinel last)
+  {
+    std::size_t old_size = size_;
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+    std::rotate(data_ + index, data_ + old_size, data_ + size_);
+  }
+
+  void release() noexcept
+  {
+    destroy(data_, data_ + size_);
+    if (!is_inline()) {
+      deallocate(data_, capacity_);
+    }
+    data_ = inline_data();
+    size_ = 0;
+    capacity_ = InlineCapacity;
+  }
+
+  // Takes over other's elements; this vector must be empty and inline, and
+  // its allocator must be able to free other's storage
+  void take(small_vector& other)
+  {
+    if (other.is_inline()) {
+      relocate(other.data_, other.data_ + other.size_, data_);
+    } else {
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+      other.data_ = other.inline_data();
+      other.capacity_ = InlineCapacity;
+    }
+    size_ = other.size_;
+    other.size_ = 0;
+  }
+
+  // Copies other's elements into this vector, which must hold no elements
+  void copy_from(const small_vector& other)
+  {
+    reserve(other.size_);
+    for (; size_ < other.size_; size_++) {
+      alloc_traits::construct(alloc_, data_ + size_, other.data_[size_]);
+    }
+  }
+
+public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = Iterator;
+
+  small_vector()
+      : small_vector(Allocator())
+  {
+  }
+
+  explicit small_vector(const Allocator& alloc)
+      : size_(0)
+      , capacity_(InlineCapacity)
+      , data_(inline_data())
+      , alloc_(alloc)
+  {
+  }
+
+  small_vector(std::initializer_list<T> elements,
+               const Allocator& alloc = Allocator())
+      : small_vector(alloc)
+  {
+    reserve(elements.size());
+    for (const T& element : elements) {
+      alloc_traits::construct(alloc_, data_ + size_, element);
+      ++size_;
+    }
+  }
+
+  explicit small_vector(std::size_t initial_size,
+                        const Allocator& alloc = Allocator())
+      : small_vector(alloc)
+  {
+    resize(initial_size);
+  }
+
+  explicit small_vector(std::size_t initial_size,
+                        const T& initial_element,
+                        const Allocator& alloc = Allocator())
+      : small_vector(alloc)
+  {
+    assign(initial_size, initial_element);
+  }
+
+  small_vector(small_vector&& other) noexcept(
+      bitwise_relocatable || std::is_nothrow_move_constructible_v<T>)
+      : small_vector(std::move(other.alloc_))
+  {
+    take(other);
+  }
+
+  small_vector(const small_vector& other)
+      : small_vector(
+            alloc_traits::select_on_container_copy_construction(other.alloc_))
+  {
+    copy_from(other);
+  }
+
+  small_vector& operator=(small_vector&& other) noexcept(
+      (bitwise_relocatable || std::is_nothrow_move_constructible_v<T>)
+      && (alloc_traits::propagate_on_container_move_assignment::value
+          || alloc_traits::is_always_equal::value))
+  {
+    if (this == &other) {
+      return *this;
+    }
+
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value
+                  || alloc_traits::is_always_equal::value)
+    {
+      release();
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                        value) {
+        alloc_ = std::move(other.alloc_);
+      }
+      take(other);
+    } else if (alloc_ == other.alloc_) {
+      release();
+      take(other);
+    } else {
+      // Storage can't change hands, so move the elements one by one
+      clear();
+      reserve(other.size_);
+      for (; size_ < other.size_; size_++) {
+        alloc_traits::construct(
+            alloc_, data_ + size_, std::move(other.data_[size_]));
+      }
+      other.clear();
+    }
+
+    return *this;
+  }
+
+  small_vector& operator=(const small_vector& other)
+  {
+    if (this == &other) {
+      return *this;
+    }
+
+    clear();
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+    {
+      if (alloc_ != other.alloc_) {
+        release();
+      }
+      alloc_ = other.alloc_;
+    }
+    copy_from(other);
+
+    return *this;
+  }
+
+  ~small_vector() { release(); }
+
+  static constexpr std::size_t inline_capacity() noexcept
+  {
+    return InlineCapacity;
+  }
+
+  // Whether the elements currently live in the inline storage
+  bool is_inline() const noexcept { return data_ == inline_data(); }
+
+  std::size_t capacity() const noexcept { return capacity_; }
+
+  allocator_type get_allocator() const noexcept { return alloc_; }
+
+  const T& operator[](std::size_t index) const { return data_[index]; }
+  T& operator[](std::size_t index) { return data_[index]; }
+
+  void resize(std::size_t new_size)
+  {
+    if (new_size < size_) {
+      destroy(data_ + new_size, data_ + size_);
+      size_ = new_size;
+      return;
+    }
+
+    reserve(new_size);
+    for (; size_ < new_size; size_++) {
+      alloc_traits::construct(alloc_, data_ + size_);
+    }
+  }
+
+  template<typename... Args>
+  T& emplace_back(Args&&... args)
+  {
+    if (size_ == capacity_) {
+      // args may refer into this vector, so build the element before the
+      // buffer moves
+      T element(std::forward<Args>(args)...);
+      grow();
+      alloc_traits::construct(alloc_, data_ + size_, std::move(element));
+    } else {
+      alloc_traits::construct(
+          alloc_, data_ + size_, std::forward<Args>(args)...);
+    }
+    return data_[size_++];
+  }
+
+  void push_back(const T& element) { emplace_back(element); }
+  void push_back(T&& element) { emplace_back(std::move(element)); }
+
+  void pop_back()
+  {
+    if (size_ == 0) {
+      throw std::runtime_error("Unable to pop vector with 0 elements");
+    }
+    size_--;
+    alloc_traits::destroy(alloc_, data_ + size_);
+  }
+
+  template<typename... Args>
+  Iterator emplace(Iterator it, Args&&... args)
+  {
+    auto index = static_cast<std::size_t>(it - begin());
+    if (index == size_) {
+      emplace_back(std::forward<Args>(args)...);
+    } else {
+      // The temporary keeps args that refer into this vector valid
+      insert_at(index, T(std::forward<Args>(args)...));
+    }
+    return begin() + static_cast<std::ptrdiff_t>(index);
+  }
+
+  Iterator insert(Iterator it, const T& element)
+  {
+    return emplace(it, element);
+  }
+
+  Iterator insert(Iterator it, T&& element)
+  {
+    return emplace(it, std::move(element));
+  }
+
+  // Inserts [first, last), which must not point into this vector. Forward
+  // iterators reserve once.
+  template<std::input_iterator InputIt>
+  Iterator insert(Iterator it, InputIt first, InputIt last)
+  {
+    auto index = static_cast<std::size_t>(it - begin());
+    if constexpr (std::forward_iterator<InputIt>) {
+      grow(static_cast<std::size_t>(std::distance(first, last)));
+    }
+    insert_rotate(index, std::move(first), last);
+    return begin() + static_cast<std::ptrdiff_t>(index);
+  }
+
+  // Range counterparts of the above, with the same restriction
+  template<std::ranges::input_range Range>
+  Iterator insert_range(Iterator it, Range&& range)
+  {
+    auto index = static_cast<std::size_t>(it - begin());
+    if constexpr (std::ranges::forward_range<Range>
+                  || std::ranges::sized_range<Range>)
+    {
+      grow(static_cast<std::size_t>(std::ranges::distance(range)));
+    }
+    insert_rotate(index, std::ranges::begin(range), std::ranges::end(range));
+    return begin() + static_cast<std::ptrdiff_t>(index);
+  }
+
+  template<std::ranges::input_range Range>
+  void append_range(Range&& range)
+  {
+    insert_range(end(), std::forward<Range>(range));
+  }
+
+  Iterator erase(Iterator it)
+  {
+    if constexpr (bitwise_relocatable) {
+      T* pos = &*it;
+      alloc_traits::destroy(alloc_, pos);
+      std::memmove(static_cast<void*>(pos),
+                   static_cast<const void*>(pos + 1),
+                   static_cast<std::size_t>(data_ + size_ - pos - 1)
+                       * sizeof(T));
+      --size_;
+    } else {
+      std::move(it + 1, end(), it);
+      --size_;
+      alloc_traits::destroy(alloc_, data_ + size_);
+    }
+    return it;
+  }
+
+  Iterator begin() { return data_; }
+  Iterator end() { return data_ + size_; }
+
+  T& at(std::size_t idx)
+  {
+    if (idx >= size_) {
+      throw std::out_of_range("Index out of bounds");
+    }
+    return data_[idx];
+  }
+
+  T& front() { return data_[0]; }
+  T& back() { return data_[size_ - 1]; }
+
+  T* data() noexcept { return data_; }
+  const T* data() const noexcept { return data_; }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  void clear() noexcept
+  {
+    destroy(data_, data_ + size_);
+    size_ = 0;
+  }
+
+  std::size_t size() const { return size_; }
+
+  void assign(std::size_t size, const T& element)
+  {
+    clear();
+    reserve(size);
+    for (; size_ < size; size_++) {
+      alloc_traits::construct(alloc_, data_ + size_, element);
+    }
+  }
+
+  void reserve(std::size_t new_capacity)
+  {
+    if (capacity_ < new_capacity) {
+      reallocate(new_capacity);
+    }
+  }
+
+  void shrink_to_fit()
+  {
+    if (size_ < capacity_) {
+      reallocate(size_);
+    }
+  }
+
+  std::strong_ordering operator<=>(const small_vector& other) const noexcept
+  {
+    if (size_ != other.size_) {
+      return size_ <=> other.size_;
+    }
+
+    for (std::size_t i = 0; i < size_; i++) {
+      if (data_[i] != other.data_[i]) {
+        return data_[i] <=> other.data_[i];
+      }
+    }
+
+    return std::strong_ordering::equal;
+  }
+
+  bool operator==(const small_vector& other) const noexcept
+  {
+    return *this <=> other == std::strong_ordering::equal;
+  }
+
+  void swap(small_vector& other)
+  {
+    if (!is_inline() && !other.is_inline()) {
+      if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        std::swap(alloc_, other.alloc_);
+      }
+      std::swap(data_, other.data_);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+      return;
+    }
+
+    small_vector tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+};
+}  // namespace steev
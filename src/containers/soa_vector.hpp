@@ -0,0 +1,512 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "containers/growth_policy.hpp"
+#include "memory/allocator.hpp"
+#include "memory/relocate.hpp"
+
+namespace steev
+{
+// Structure-of-arrays vector: a record of Fields... is stored as one
+// element in each of sizeof...(Fields) parallel buffers, so a scan over a
+// single field streams through that field's memory only. column<I>() hands
+// out field I as a span; iterators and operator[] yield tuples of
+// references to one record's fields.
+template<typename... Fields>
+class soa_vector
+{
+  static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+
+  using indices = std::index_sequence_for<Fields...>;
+
+  template<std::size_t I>
+  using field_t = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+  std::tuple<Fields*...> columns_ {};
+  std::size_t size_ = 0;
+  std::size_t capacity_ = 0;
+
+  // Iterates records as tuples of references into every column. Like
+  // views::zip, it only models random_access_iterator once the standard
+  // library has the C++23 common_reference for tuples of references.
+  template<bool Const>
+  class basic_iterator
+  {
+    template<typename F>
+    using field = std::conditional_t<Const, const F, F>;
+
+    std::tuple<field<Fields>*...> columns_ {};
+    std::ptrdiff_t index_ = 0;
+
+    friend class soa_vector;
+    friend class basic_iterator<!Const>;
+
+    basic_iterator(std::tuple<field<Fields>*...> columns,
+                   std::ptrdiff_t index) noexcept
+        : columns_(columns)
+        , index_(index)
+    {
+    }
+
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = std::tuple<Fields...>;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::tuple<field<Fields>&...>;
+
+    basic_iterator() noexcept = default;
+
+    // Mutable iterators convert to const ones
+    template<bool OtherConst>
+      requires(Const && !OtherConst)
+    basic_iterator(const basic_iterator<OtherConst>& other) noexcept
+        : columns_(other.columns_)
+        , index_(other.index_)
+    {
+    }
+
+    reference operator*() const
+    {
+      return std::apply([this](auto*... column)
+                        { return reference(column[index_]...); },
+                        columns_);
+    }
+
+    reference operator[](difference_type offset) const
+    {
+      return *(*this + offset);
+    }
+
+    basic_iterator& operator++() noexcept
+    {
+      ++index_;
+      return *this;
+    }
+
+    basic_iterator operator++(int) noexcept
+    {
+      basic_iterator copy = *this;
+      ++index_;
+      return copy;
+    }
+
+    basic_iterator& operator--() noexcept
+    {
+      --index_;
+      return *this;
+    }
+
+    basic_iterator operator--(int) noexcept
+    {
+      basic_iterator copy = *this;
+      --index_;
+      return copy;
+    }
+
+    basic_iterator& operator+=(difference_type offset) noexcept
+    {
+      index_ += offset;
+      return *this;
+    }
+
+    basic_iterator& operator-=(difference_type offset) noexcept
+    {
+      index_ -= offset;
+      return *this;
+    }
+
+    friend basic_iterator operator+(basic_iterator it,
+                                    difference_type offset) noexcept
+    {
+      return it += offset;
+    }
+
+    friend basic_iterator operator+(difference_type offset,
+                                    basic_iterator it) noexcept
+    {
+      return it += offset;
+    }
+
+    friend basic_iterator operator-(basic_iterator it,
+                                    difference_type offset) noexcept
+    {
+      return it -= offset;
+    }
+
+    friend difference_type operator-(const basic_iterator& lhs,
+                                     const basic_iterator& rhs) noexcept
+    {
+      return lhs.index_ - rhs.index_;
+    }
+
+    friend bool operator==(const basic_iterator& lhs,
+                           const basic_iterator& rhs) noexcept
+    {
+      return lhs.index_ == rhs.index_;
+    }
+
+    friend std::strong_ordering operator<=>(const basic_iterator& lhs,
+                                            const basic_iterator& rhs) noexcept
+    {
+      return lhs.index_ <=> rhs.index_;
+    }
+  };
+
+  template<std::size_t I>
+  field_t<I>* column_data() const noexcept
+  {
+    return std::get<I>(columns_);
+  }
+
+  // Destroys field I of records [first, last)
+  template<std::size_t I>
+  void destroy_field(std::size_t first, std::size_t last) noexcept
+  {
+    std::destroy(column_data<I>() + first, column_data<I>() + last);
+  }
+
+  void destroy(std::size_t first, std::size_t last) noexcept
+  {
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+      (destroy_field<I>(first, last), ...);
+    }(indices {});
+  }
+
+  // Builds the record at size_ field by field; if one throws, the fields
+  // already built are destroyed again
+  template<typename... Args>
+  void construct_back(Args&&... args)
+  {
+    std::size_t built = 0;
+    try {
+      [&]<std::size_t... I>(std::index_sequence<I...>)
+      {
+        ((std::construct_at(column_data<I>() + size_,
+                            std::forward<Args>(args)),
+          ++built),
+         ...);
+      }(indices {});
+    } catch (...) {
+      [&]<std::size_t... I>(std::index_sequence<I...>)
+      {
+        ((I < built ? std::destroy_at(column_data<I>() + size_) : void()),
+         ...);
+      }(indices {});
+      throw;
+    }
+    size_++;
+  }
+
+  template<std::size_t I>
+  void deallocate_field(field_t<I>* ptr, std::size_t count) noexcept
+  {
+    if (ptr != nullptr) {
+      allocator<field_t<I>>().deallocate(ptr, count);
+    }
+  }
+
+  // Fields that can throw while being moved are copied, and those go
+  // first: once a column has been moved from, nothing after it may throw
+  template<std::size_t I>
+  static constexpr bool copies_field =
+      !std::is_nothrow_move_constructible_v<field_t<I>>;
+
+  // Moves (or copies) field I into dest, leaving the originals for
+  // reallocate to destroy
+  template<std::size_t I>
+  void transfer_field(field_t<I>* dest)
+  {
+    using F = field_t<I>;
+    F* source = column_data<I>();
+    if constexpr (is_trivially_relocatable_v<F>
+                  && std::is_trivially_destructible_v<F>)
+    {
+      uninitialized_relocate(source, source + size_, dest);
+    } else {
+      std::size_t i = 0;
+      try {
+        for (; i < size_; i++) {
+          std::construct_at(dest + i, std::move_if_noexcept(source[i]));
+        }
+      } catch (...) {
+        std::destroy(dest, dest + i);
+        throw;
+      }
+    }
+  }
+
+  // Moves every column into buffers of new_capacity. Nothing changes if an
+  // allocation or a copy throws.
+  void reallocate(std::size_t new_capacity)
+  {
+    std::tuple<Fields*...> fresh {};
+    bool filled[sizeof...(Fields)] {};
+
+    try {
+      [&]<std::size_t... I>(std::index_sequence<I...>)
+      {
+        ((std::get<I>(fresh) = allocator<Fields>().allocate(new_capacity)),
+         ...);
+        ((copies_field<I> ? (transfer_field<I>(std::get<I>(fresh)),
+                             filled[I] = true)
+                          : false),
+         ...);
+        ((copies_field<I> ? false
+                          : (transfer_field<I>(std::get<I>(fresh)),
+                             filled[I] = true)),
+         ...);
+      }(indices {});
+    } catch (...) {
+      [&]<std::size_t... I>(std::index_sequence<I...>)
+      {
+        ((filled[I] ? std::destroy(std::get<I>(fresh),
+                                   std::get<I>(fresh) + size_)
+                    : void()),
+         ...);
+        (deallocate_field<I>(std::get<I>(fresh), new_capacity), ...);
+      }(indices {});
+      throw;
+    }
+
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+      (destroy_field<I>(0, size_), ...);
+      (deallocate_field<I>(column_data<I>(), capacity_), ...);
+    }(indices {});
+    columns_ = fresh;
+    capacity_ = new_capacity;
+  }
+
+  void grow()
+  {
+    if (size_ == capacity_) {
+      reallocate(doubling_growth::next_capacity(capacity_, size_ + 1));
+    }
+  }
+
+  void release() noexcept
+  {
+    destroy(0, size_);
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+      (deallocate_field<I>(column_data<I>(), capacity_), ...);
+    }(indices {});
+    columns_ = {};
+    size_ = 0;
+    capacity_ = 0;
+  }
+
+public:
+  using value_type = std::tuple<Fields...>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::tuple<Fields&...>;
+  using const_reference = std::tuple<const Fields&...>;
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  soa_vector() noexcept = default;
+
+  soa_vector(std::initializer_list<value_type> records)
+  {
+    reserve(records.size());
+    for (const value_type& record : records) {
+      push_back(record);
+    }
+  }
+
+  soa_vector(const soa_vector& other)
+  {
+    reserve(other.size_);
+    for (std::size_t i = 0; i < other.size_; i++) {
+      std::apply([this](const Fields&... fields) { construct_back(fields...); },
+                 other[i]);
+    }
+  }
+
+  soa_vector(soa_vector&& other) noexcept
+      : columns_(std::exchange(other.columns_, {}))
+      , size_(std::exchange(other.size_, 0))
+      , capacity_(std::exchange(other.capacity_, 0))
+  {
+  }
+
+  soa_vector& operator=(const soa_vector& other)
+  {
+    if (this != &other) {
+      soa_vector copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  soa_vector& operator=(soa_vector&& other) noexcept
+  {
+    if (this != &other) {
+      release();
+      swap(other);
+    }
+    return *this;
+  }
+
+  ~soa_vector() { release(); }
+
+  std::size_t size() const noexcept { return size_; }
+  std::size_t capacity() const noexcept { return capacity_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  void reserve(std::size_t new_capacity)
+  {
+    if (capacity_ < new_capacity) {
+      reallocate(new_capacity);
+    }
+  }
+
+  void shrink_to_fit()
+  {
+    if (size_ < capacity_) {
+      if (size_ == 0) {
+        release();
+      } else {
+        reallocate(size_);
+      }
+    }
+  }
+
+  void clear() noexcept
+  {
+    destroy(0, size_);
+    size_ = 0;
+  }
+
+  // Field I of every record, in one contiguous buffer
+  template<std::size_t I>
+  std::span<field_t<I>> column() noexcept
+  {
+    return {column_data<I>(), size_};
+  }
+
+  template<std::size_t I>
+  std::span<const field_t<I>> column() const noexcept
+  {
+    return {column_data<I>(), size_};
+  }
+
+  reference operator[](std::size_t index)
+  {
+    return std::apply([index](Fields*... column)
+                      { return reference(column[index]...); },
+                      columns_);
+  }
+
+  const_reference operator[](std::size_t index) const
+  {
+    return std::apply([index](Fields*... column)
+                      { return const_reference(column[index]...); },
+                      columns_);
+  }
+
+  reference at(std::size_t index)
+  {
+    if (index >= size_) {
+      throw std::out_of_range("Index out of bounds");
+    }
+    return (*this)[index];
+  }
+
+  reference front() { return (*this)[0]; }
+  reference back() { return (*this)[size_ - 1]; }
+
+  iterator begin() noexcept { return {columns_, 0}; }
+  iterator end() noexcept
+  {
+    return {columns_, static_cast<std::ptrdiff_t>(size_)};
+  }
+  const_iterator begin() const noexcept { return {columns_, 0}; }
+  const_iterator end() const noexcept
+  {
+    return {columns_, static_cast<std::ptrdiff_t>(size_)};
+  }
+
+  // Takes one argument per field, each used to construct that field
+  template<typename... Args>
+    requires(sizeof...(Args) == sizeof...(Fields))
+  reference emplace_back(Args&&... args)
+  {
+    if (size_ == capacity_) {
+      // args may refer into the columns, so copy them out before they move
+      value_type record(std::forward<Args>(args)...);
+      grow();
+      std::apply([this](Fields&... fields)
+                 { construct_back(std::move(fields)...); },
+                 record);
+    } else {
+      construct_back(std::forward<Args>(args)...);
+    }
+    return back();
+  }
+
+  void push_back(const value_type& record)
+  {
+    std::apply([this](const Fields&... fields) { emplace_back(fields...); },
+               record);
+  }
+
+  void push_back(value_type&& record)
+  {
+    std::apply([this](Fields&... fields)
+               { emplace_back(std::move(fields)...); },
+               record);
+  }
+
+  void pop_back()
+  {
+    if (size_ == 0) {
+      throw std::runtime_error("Unable to pop vector with 0 elements");
+    }
+    size_--;
+    destroy(size_, size_ + 1);
+  }
+
+  // Shifts every column down over the erased record
+  iterator erase(const_iterator it)
+  {
+    auto index = static_cast<std::size_t>(it.index_);
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+      (std::move(column_data<I>() + index + 1,
+                 column_data<I>() + size_,
+                 column_data<I>() + index),
+       ...);
+    }(indices {});
+    pop_back();
+    return begin() + it.index_;
+  }
+
+  void swap(soa_vector& other) noexcept
+  {
+    std::swap(columns_, other.columns_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  friend bool operator==(const soa_vector& lhs, const soa_vector& rhs)
+  {
+    return lhs.size_ == rhs.size_
+        && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+};
+}  // namespace steev
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "containers/vector.hpp"
+
+// Searches over the sorted keys of steev::flat_map and flat_set. The layout
+// tag picks how a lookup walks them:
+//
+// sorted_layout searches the sorted keys themselves with a binary search
+// whose halving step compiles to a conditional move, so a lookup never
+// mispredicts, at the cost of always taking log2(n) steps.
+//
+// eytzinger_layout keeps a second copy of the keys in breadth-first order
+// of the implicit search tree (node k has children 2k and 2k + 1), padded
+// to a perfect tree. The first levels of the tree share a few cache lines,
+// and the four levels below the current node sit in one block of 16 that is
+// prefetched while the current one is compared, so large tables take fewer
+// cache misses per lookup. It costs the copy, up to twice the keys with the
+// padding, and a rebuild on every insert or erase. A rebuild that throws
+// falls back to sorted_layout's search rather than fail the insert or erase
+// that triggered it.
+
+namespace steev
+{
+// Tag for the constructors that take keys already sorted and free of
+// duplicates, and so skip the sort
+struct sorted_unique_t
+{
+  explicit sorted_unique_t() = default;
+};
+
+inline constexpr sorted_unique_t sorted_unique {};
+
+struct sorted_layout
+{
+};
+
+struct eytzinger_layout
+{
+};
+
+namespace detail
+{
+// Index of the first key for which before(key) is false, with before
+// true for a prefix of keys
+template<typename Key, typename Before>
+std::size_t branchless_partition(const Key* keys,
+                                 std::size_t count,
+                                 Before before)
+{
+  if (count == 0) {
+    return 0;
+  }
+  const Key* base = keys;
+  while (count > 1) {
+    std::size_t half = count / 2;
+    base = before(base[half]) ? base + half : base;
+    count -= half;
+  }
+  return static_cast<std::size_t>(base - keys) + (before(*base) ? 1 : 0);
+}
+
+template<typename Key, typename Layout>
+class search_index;
+
+// Searches the sorted keys directly, so there is nothing to keep
+template<typename Key>
+class search_index<Key, sorted_layout>
+{
+public:
+  void build(const Key*, std::size_t) {}
+
+  template<typename Before>
+  std::size_t partition(const Key* keys,
+                        std::size_t count,
+                        Before before) const
+  {
+    return branchless_partition(keys, count, before);
+  }
+};
+
+template<typename Key>
+class search_index<Key, eytzinger_layout>
+{
+  // A perfect tree: node 0 is unused so the children of k are 2k and
+  // 2k + 1, and the nodes past the last key repeat it
+  vector<Key> tree_;
+
+  // Nodes four levels down from k start at 16k
+  static constexpr std::size_t prefetch_levels = 16;
+
+  void fill(const Key* sorted,
+            std::size_t count,
+            std::size_t& next,
+            std::size_t node)
+  {
+    if (node < tree_.size()) {
+      fill(sorted, count, next, 2 * node);
+      tree_[node] = sorted[std::min(next++, count - 1)];
+      fill(sorted, count, next, 2 * node + 1);
+    }
+  }
+
+public:
+  // Called once the keys have already changed, so it can't fail: if the
+  // tree can't be allocated or filled it is dropped, and lookups search
+  // the sorted keys directly until a later build succeeds
+  void build(const Key* sorted, std::size_t count) noexcept
+  {
+    tree_.clear();
+    if (count == 0) {
+      return;
+    }
+    try {
+      tree_.resize(std::bit_ceil(count + 1));
+      std::size_t next = 0;
+      fill(sorted, count, next, 1);
+    } catch (...) {
+      tree_.clear();
+    }
+  }
+
+  template<typename Before>
+  std::size_t partition(const Key* keys,
+                        std::size_t count,
+                        Before before) const
+  {
+    if (tree_.empty()) {
+      return branchless_partition(keys, count, before);
+    }
+    const Key* tree = tree_.data();
+    std::size_t leaves = tree_.size();
+    std::size_t node = 1;
+    while (node < leaves) {
+#if defined(__GNUC__) || defined(__clang__)
+      // Only a hint, so running past the end of the tree does no harm;
+      // the address is formed as an integer to keep the pointer in bounds
+      __builtin_prefetch(reinterpret_cast<const void*>(
+          reinterpret_cast<std::uintptr_t>(tree)
+          + node * prefetch_levels * sizeof(Key)));
+#endif
+      node = 2 * node + (before(tree[node]) ? 1 : 0);
+    }
+    // Every search takes the same number of steps and ends below the
+    // leaves, on the gap between keys it belongs in, numbered left to right
+    // from leaves. The padding only ever adds gaps past the last key.
+    return std::min(node - leaves, count);
+  }
+};
+}  // namespace detail
+}  // namespace steev
@@ -0,0 +1,357 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "containers/vector.hpp"
+#include "memory/allocator.hpp"
+
+namespace steev
+{
+// Elements per chunk when none is given: about a 4 KiB page of them
+template<typename T>
+inline constexpr std::size_t default_chunk_size =
+    std::max<std::size_t>(std::bit_floor(4096 / sizeof(T)), 16);
+
+// Vector made of fixed-size chunks that never move once allocated. Growing
+// adds a chunk instead of reallocating, so pointers, references and
+// iterators stay valid until their element is erased, and an append never
+// copies the elements already there. Iterators belong to this object,
+// though, and don't follow the elements through a move or swap. Element i
+// lives at chunk i / ChunkSize, which the power-of-two ChunkSize turns into
+// a shift and a mask.
+template<typename T, std::size_t ChunkSize = default_chunk_size<T>>
+class stable_vector
+{
+  static_assert(std::has_single_bit(ChunkSize),
+                "ChunkSize has to be a power of two");
+
+  static constexpr std::size_t shift = std::countr_zero(ChunkSize);
+  static constexpr std::size_t mask = ChunkSize - 1;
+
+  // Random access iterator that looks its chunk up on every dereference.
+  // It goes through the container's table of chunks rather than caching
+  // the table's buffer, which moves whenever a chunk is added.
+  template<bool Const>
+  class basic_iterator
+  {
+    using Chunks = vector<T*>;
+
+    const Chunks* chunks_ = nullptr;
+    std::size_t index_ = 0;
+
+    friend class stable_vector;
+    friend class basic_iterator<!Const>;
+
+    basic_iterator(const Chunks* chunks, std::size_t index) noexcept
+        : chunks_(chunks)
+        , index_(index)
+    {
+    }
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    basic_iterator() noexcept = default;
+
+    // Mutable iterators convert to const ones
+    template<bool OtherConst>
+      requires(Const && !OtherConst)
+    basic_iterator(const basic_iterator<OtherConst>& other) noexcept
+        : chunks_(other.chunks_)
+        , index_(other.index_)
+    {
+    }
+
+    // Dereference operator
+    reference operator*() const
+    {
+      return (*chunks_)[index_ >> shift][index_ & mask];
+    }
+
+    // Arrow operator
+    pointer operator->() const { return &**this; }
+
+    // Subscript operator
+    reference operator[](difference_type offset) const
+    {
+      return *(*this + offset);
+    }
+
+    // Increment operators (pre-increment and post-increment)
+    basic_iterator& operator++() noexcept
+    {
+      ++index_;
+      return *this;
+    }
+
+    basic_iterator operator++(int) noexcept
+    {
+      basic_iterator temp = *this;
+      ++index_;
+      return temp;
+    }
+
+    // Decrement operators (pre-decrement and post-decrement)
+    basic_iterator& operator--() noexcept
+    {
+      --index_;
+      return *this;
+    }
+
+    basic_iterator operator--(int) noexcept
+    {
+      basic_iterator temp = *this;
+      --index_;
+      return temp;
+    }
+
+    // Compound assignment operators
+    basic_iterator& operator+=(difference_type incr) noexcept
+    {
+      index_ += static_cast<std::size_t>(incr);
+      return *this;
+    }
+
+    basic_iterator& operator-=(difference_type decr) noexcept
+    {
+      index_ -= static_cast<std::size_t>(decr);
+      return *this;
+    }
+
+    // Addition and subtraction with a difference type
+    friend basic_iterator operator+(basic_iterator it,
+                                    difference_type incr) noexcept
+    {
+      return it += incr;
+    }
+
+    friend basic_iterator operator+(difference_type incr,
+                                    basic_iterator it) noexcept
+    {
+      return it += incr;
+    }
+
+    friend basic_iterator operator-(basic_iterator it,
+                                    difference_type decr) noexcept
+    {
+      return it -= decr;
+    }
+
+    // Difference between two iterators
+    friend difference_type operator-(const basic_iterator& lhs,
+                                     const basic_iterator& rhs) noexcept
+    {
+      return static_cast<difference_type>(lhs.index_)
+          - static_cast<difference_type>(rhs.index_);
+    }
+
+    // Comparison operators
+    friend bool operator==(const basic_iterator& lhs,
+                           const basic_iterator& rhs) noexcept
+    {
+      return lhs.index_ == rhs.index_;
+    }
+
+    friend auto operator<=>(const basic_iterator& lhs,
+                            const basic_iterator& rhs) noexcept
+    {
+      return lhs.index_ <=> rhs.index_;
+    }
+  };
+
+  // Only the table of chunk pointers is reallocated as the vector grows
+  vector<T*> chunks_;
+  std::size_t size_ = 0;
+
+  T* slot(std::size_t index) const noexcept
+  {
+    return chunks_[index >> shift] + (index & mask);
+  }
+
+  void add_chunk()
+  {
+    T* chunk = allocator<T>().allocate(ChunkSize);
+    try {
+      chunks_.push_back(chunk);
+    } catch (...) {
+      allocator<T>().deallocate(chunk, ChunkSize);
+      throw;
+    }
+  }
+
+  // Frees the chunks past the ones holding new_size elements
+  void free_chunks_after(std::size_t new_size) noexcept
+  {
+    std::size_t keep = (new_size + mask) >> shift;
+    while (chunks_.size() > keep) {
+      allocator<T>().deallocate(chunks_.back(), ChunkSize);
+      chunks_.pop_back();
+    }
+  }
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  static constexpr std::size_t chunk_size = ChunkSize;
+
+  stable_vector() noexcept = default;
+
+  stable_vector(std::initializer_list<T> elements)
+  {
+    reserve(elements.size());
+    for (const T& element : elements) {
+      emplace_back(element);
+    }
+  }
+
+  stable_vector(const stable_vector& other)
+  {
+    reserve(other.size_);
+    for (const T& element : other) {
+      emplace_back(element);
+    }
+  }
+
+  stable_vector(stable_vector&& other) noexcept
+      : chunks_(std::move(other.chunks_))
+      , size_(std::exchange(other.size_, 0))
+  {
+  }
+
+  stable_vector& operator=(const stable_vector& other)
+  {
+    if (this != &other) {
+      stable_vector copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  stable_vector& operator=(stable_vector&& other) noexcept
+  {
+    stable_vector moved(std::move(other));
+    swap(moved);
+    return *this;
+  }
+
+  ~stable_vector()
+  {
+    clear();
+    free_chunks_after(0);
+  }
+
+  std::size_t size() const noexcept { return size_; }
+  std::size_t capacity() const noexcept { return chunks_.size() * ChunkSize; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  // Allocates chunks up front; existing elements stay where they are
+  void reserve(std::size_t new_capacity)
+  {
+    while (capacity() < new_capacity) {
+      add_chunk();
+    }
+  }
+
+  // Frees the chunks no element lives in
+  void shrink_to_fit() noexcept { free_chunks_after(size_); }
+
+  T& operator[](std::size_t index) { return *slot(index); }
+  const T& operator[](std::size_t index) const { return *slot(index); }
+
+  T& at(std::size_t idx)
+  {
+    if (idx >= size_) {
+      throw std::out_of_range("Index out of bounds");
+    }
+    return *slot(idx);
+  }
+
+  const T& at(std::size_t idx) const
+  {
+    if (idx >= size_) {
+      throw std::out_of_range("Index out of bounds");
+    }
+    return *slot(idx);
+  }
+
+  T& front() { return *slot(0); }
+  T& back() { return *slot(size_ - 1); }
+
+  iterator begin() noexcept { return {&chunks_, 0}; }
+  iterator end() noexcept { return {&chunks_, size_}; }
+  const_iterator begin() const noexcept { return {&chunks_, 0}; }
+  const_iterator end() const noexcept { return {&chunks_, size_}; }
+
+  // args may refer to an element, which stays put while a chunk is added
+  template<typename... Args>
+  T& emplace_back(Args&&... args)
+  {
+    if (size_ == capacity()) {
+      add_chunk();
+    }
+    T* element = std::construct_at(slot(size_), std::forward<Args>(args)...);
+    size_++;
+    return *element;
+  }
+
+  void push_back(const T& element) { emplace_back(element); }
+  void push_back(T&& element) { emplace_back(std::move(element)); }
+
+  void pop_back()
+  {
+    if (size_ == 0) {
+      throw std::runtime_error("Unable to pop vector with 0 elements");
+    }
+    size_--;
+    std::destroy_at(slot(size_));
+  }
+
+  // Keeps the chunks for reuse
+  void clear() noexcept
+  {
+    while (size_ > 0) {
+      size_--;
+      std::destroy_at(slot(size_));
+    }
+  }
+
+  // Shifts the later elements down, so only references before it survive
+  iterator erase(const_iterator it)
+  {
+    iterator first = begin() + static_cast<difference_type>(it.index_);
+    std::move(first + 1, end(), first);
+    pop_back();
+    return first;
+  }
+
+  void swap(stable_vector& other) noexcept
+  {
+    chunks_.swap(other.chunks_);
+    std::swap(size_, other.size_);
+  }
+
+  friend bool operator==(const stable_vector& lhs, const stable_vector& rhs)
+  {
+    return lhs.size_ == rhs.size_
+        && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+};
+}  // namespace steev
@@ -3,279 +3,628 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <compare>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
+#include <ranges>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "containers/growth_policy.hpp"
+#include "containers/pointer_iterator.hpp"
+#include "containers/simd.hpp"
+#include "memory/allocator.hpp"
+#include "memory/allocator_traits.hpp"
+#include "memory/instrumentation.hpp"
+#include "memory/relocate.hpp"
 
 namespace steev
 {
-template<typename T>
+// Tag for the sized constructor that leaves trivially default constructible
+// elements uninitialized
+struct for_overwrite_t
+{
+  explicit for_overwrite_t() = default;
+};
+
+inline constexpr for_overwrite_t for_overwrite {};
+
+// GrowthPolicy decides how far the capacity jumps when the vector is full;
+// see growth_policy.hpp
+template<typename T,
+         typename Allocator = steev::allocator<T>,
+         typename GrowthPolicy = doubling_growth>
 class vector
 {
-  class Iterator
+  using Iterator = pointer_iterator<T>;
+
+  using alloc_traits = allocator_traits<Allocator>;
+
+  static_assert(std::is_same_v<typename alloc_traits::value_type, T>,
+                "Allocator::value_type must match the vector's value type");
+  static_assert(std::is_same_v<typename alloc_traits::pointer, T*>,
+                "Only allocators handing out raw pointers are supported");
+
+  std::size_t size_;
+  std::size_t capacity_;
+  T* data_;
+  [[no_unique_address]] Allocator alloc_;
+
+  allocation_result<T*> allocate(std::size_t count)
   {
-    T* ptr_;
+    if (count == 0) {
+      return {nullptr, 0};
+    }
+    allocation_result<T*> result {nullptr, count};
+    if constexpr (GrowthPolicy::round_to_allocation) {
+      result = alloc_traits::allocate_at_least(alloc_, count);
+    } else {
+      result.ptr = alloc_traits::allocate(alloc_, count);
+    }
+    instrumentation::on_allocate<vector>(result.count * sizeof(T));
+    return result;
+  }
 
-  public:
-    using iterator_category = std::random_access_iterator_tag;
-    using value_type = T;
-    using difference_type = std::ptrdiff_t;
-    using pointer = value_type*;
-    using reference = value_type&;
+  void deallocate(T* ptr, std::size_t count) noexcept
+  {
+    if (ptr != nullptr) {
+      alloc_traits::deallocate(alloc_, ptr, count);
+      instrumentation::on_deallocate<vector>();
+    }
+  }
 
-    Iterator(T* ptr)
-        : ptr_(ptr)
-    {
+  void destroy(T* first, T* last) noexcept
+  {
+    for (; first != last; ++first) {
+      alloc_traits::destroy(alloc_, first);
     }
+  }
 
-    // Dereference operator
-    reference operator*() const { return *ptr_; }
+  // Elements can be moved with memcpy/memmove instead of one at a time
+  static constexpr bool bitwise_relocatable = is_trivially_relocatable_v<T>
+      && alloc_traits::template uses_default_construct<T>;
 
-    // Arrow operator
-    pointer operator->() const { return ptr_; }
+  // Default-initializing an element does nothing, so resize_for_overwrite
+  // only has to move size_
+  static constexpr bool skips_default_init =
+      std::is_trivially_default_constructible_v<T>
+      && alloc_traits::template uses_default_construct<T>;
 
-    // Addition with a difference type
-    Iterator operator+(difference_type incr) const
-    {
-      return Iterator(ptr_ + incr);
+  // Relocates [first, last) into uninitialized, non-overlapping storage
+  void relocate(T* first, T* last, T* dest)
+  {
+    if constexpr (bitwise_relocatable) {
+      uninitialized_relocate(first, last, dest);
+    } else {
+      T* out = dest;
+      try {
+        for (T* it = first; it != last; ++it, ++out) {
+          alloc_traits::construct(alloc_, out, std::move_if_noexcept(*it));
+        }
+      } catch (...) {
+        destroy(dest, out);
+        throw;
+      }
+      destroy(first, last);
     }
+  }
 
-    // Subtraction with a difference type
-    Iterator operator-(difference_type decr) const
-    {
-      return Iterator(ptr_ - decr);
+  // Moves the first min(size_, new_capacity) elements into a new buffer of
+  // at least new_capacity elements
+  void reallocate(std::size_t new_capacity)
+  {
+    std::size_t kept = std::min(size_, new_capacity);
+    destroy(data_ + kept, data_ + size_);
+    size_ = kept;
+    if (data_ != nullptr) {
+      instrumentation::on_reallocate<vector>();
     }
 
-    // Increment operators (pre-increment and post-increment)
-    Iterator& operator++()
-    {
-      ++ptr_;
-      return *this;
+    if constexpr (bitwise_relocatable && alloc_traits::has_reallocate) {
+      if (data_ != nullptr && new_capacity != 0) {
+        allocation_result<T*> result {nullptr, new_capacity};
+        if constexpr (GrowthPolicy::round_to_allocation) {
+          result = alloc_traits::reallocate_at_least(
+              alloc_, data_, capacity_, new_capacity);
+        } else {
+          result.ptr =
+              alloc_traits::reallocate(alloc_, data_, capacity_, new_capacity);
+        }
+        instrumentation::on_deallocate<vector>();
+        instrumentation::on_allocate<vector>(result.count * sizeof(T));
+        data_ = result.ptr;
+        capacity_ = result.count;
+        return;
+      }
     }
 
-    Iterator operator++(int)
-    {
-      Iterator temp = *this;
-      ++ptr_;
-      return temp;
+    allocation_result<T*> allocation = allocate(new_capacity);
+    try {
+      relocate(data_, data_ + size_, allocation.ptr);
+    } catch (...) {
+      deallocate(allocation.ptr, allocation.count);
+      throw;
     }
+    deallocate(data_, capacity_);
 
-    // Decrement operators (pre-decrement and post-decrement)
-    Iterator& operator--()
-    {
-      --ptr_;
-      return *this;
+    data_ = allocation.ptr;
+    capacity_ = allocation.count;
+  }
+
+  // Makes room for count more elements
+  void grow(std::size_t count = 1)
+  {
+    if (capacity_ - size_ < count) {
+      reallocate(GrowthPolicy::next_capacity(capacity_, size_ + count));
     }
+  }
 
-    Iterator operator--(int)
-    {
-      Iterator temp = *this;
-      --ptr_;
-      return temp;
+  void insert_at(std::size_t index, T&& element)
+  {
+    if (index == size_) {
+      emplace_back(std::move(element));
+      return;
     }
+    grow();
+
+    if constexpr (bitwise_relocatable) {
+      T* hole = data_ + index;
+      std::memmove(static_cast<void*>(hole + 1),
+                   static_cast<const void*>(hole),
+                   (size_ - index) * sizeof(T));
+      try {
+        alloc_traits::construct(alloc_, hole, std::move(element));
+      } catch (...) {
+        std::memmove(static_cast<void*>(hole),
+                     static_cast<const void*>(hole + 1),
+                     (size_ - index) * sizeof(T));
+        throw;
+      }
+      ++size_;
+    } else {
+      alloc_traits::construct(
+          alloc_, data_ + size_, std::move(data_[size_ - 1]));
+      // Owns the new last element before anything else can throw
+      ++size_;
+      std::move_backward(data_ + index, data_ + size_ - 2, data_ + size_ - 1);
+      data_[index] = std::move(element);
+    }
+  }
 
-    // Difference between two iterators
-    difference_type operator-(const Iterator& other) const
-    {
-      return ptr_ - other.ptr_;
+  // Ranges of T itself that can be copied into place with one memcpy
+  template<typename It>
+  static constexpr bool memcpy_source = std::contiguous_iterator<It>
+      && std::is_same_v<std::iter_value_t<It>, T>
+      && std::is_trivially_copyable_v<T>
+      && alloc_traits::template uses_default_construct<T>;
+
+  // Constructs count elements from first in uninitialized storage at dest
+  template<typename It>
+  void construct_n(T* dest, It first, std::size_t count)
+  {
+    if constexpr (memcpy_source<It>) {
+      if (count != 0) {
+        std::memcpy(static_cast<void*>(dest),
+                    static_cast<const void*>(std::to_address(first)),
+                    count * sizeof(T));
+      }
+    } else {
+      T* out = dest;
+      try {
+        for (; out != dest + count; ++out, ++first) {
+          alloc_traits::construct(alloc_, out, *first);
+        }
+      } catch (...) {
+        destroy(dest, out);
+        throw;
+      }
     }
+  }
 
-    // Compound assignment operators
-    Iterator& operator+=(difference_type incr)
-    {
-      ptr_ += incr;
-      return *this;
+  template<typename It>
+  void insert_counted(std::size_t index, It first, std::size_t count)
+  {
+    grow(count);
+    T* hole = data_ + index;
+    std::size_t tail = size_ - index;
+
+    if constexpr (bitwise_relocatable) {
+      if (tail != 0) {
+        std::memmove(static_cast<void*>(hole + count),
+                     static_cast<const void*>(hole),
+                     tail * sizeof(T));
+      }
+      try {
+        construct_n(hole, std::move(first), count);
+      } catch (...) {
+        if (tail != 0) {
+          std::memmove(static_cast<void*>(hole),
+                       static_cast<const void*>(hole + count),
+                       tail * sizeof(T));
+        }
+        throw;
+      }
+      size_ += count;
+    } else {
+      construct_n(data_ + size_, std::move(first), count);
+      size_ += count;
+      std::rotate(hole, data_ + size_ - count, data_ + size_);
     }
+  }
 
-    Iterator& operator-=(difference_type decr)
-    {
-      ptr_ -= decr;
-      return *this;
+  // Single-pass input: append one at a time, then rotate into place
+  template<typename It, typename Sentinel>
+  void insert_input(std::size_t index, It first, Sentinel last)
+  {
+    std::size_t old_size = size_;
+    for (; first != last; ++first) {
+      emplace_back(*first);
     }
+    std::rotate(data_ + index, data_ + old_size, data_ + size_);
+  }
 
-    // Comparison operators
-    bool operator==(const Iterator& other) const { return ptr_ == other.ptr_; }
-    bool operator!=(const Iterator& other) const { return ptr_ != other.ptr_; }
-    bool operator<(const Iterator& other) const { return ptr_ < other.ptr_; }
-    bool operator<=(const Iterator& other) const { return ptr_ <= other.ptr_; }
-    bool operator>(const Iterator& other) const { return ptr_ > other.ptr_; }
-    bool operator>=(const Iterator& other) const { return ptr_ >= other.ptr_; }
-  };
+  void release() noexcept
+  {
+    destroy(data_, data_ + size_);
+    deallocate(data_, capacity_);
+    data_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+  }
 
-  std::size_t size_;
-  std::size_t capacity_;
-  T* data;
+  // Fills this vector, which must hold no elements, with count copies of
+  // element
+  void fill_empty(std::size_t count, const T& element)
+  {
+    if constexpr (simd::vectorizable<T>
+                  && alloc_traits::template uses_default_construct<T>)
+    {
+      // element may live in the buffer reserve is about to free
+      T value = element;
+      reserve(count);
+      simd::fill(data_, count, value);
+      size_ = count;
+    } else {
+      reserve(count);
+      for (; size_ < count; size_++) {
+        alloc_traits::construct(alloc_, data_ + size_, element);
+      }
+    }
+  }
 
-  void reallocate(std::size_t new_size)
+  // Copies other's elements into this vector, which must hold no elements
+  void copy_from(const vector& other)
   {
-    data = static_cast<int*>(realloc(data, sizeof(T) * new_size));
-    capacity_ = new_size;
+    if (capacity_ < other.size_) {
+      reallocate(other.size_);
+    }
+    for (; size_ < other.size_; size_++) {
+      alloc_traits::construct(alloc_, data_ + size_, other.data_[size_]);
+    }
   }
 
 public:
-  vector()
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = Iterator;
+
+  vector() noexcept(noexcept(Allocator()))
+      : vector(Allocator())
+  {
+  }
+
+  // Allocates nothing until the first element arrives
+  explicit vector(const Allocator& alloc) noexcept
       : size_(0)
-      , capacity_(10)
-      , data(new T[10])
+      , capacity_(0)
+      , data_(nullptr)
+      , alloc_(alloc)
   {
   }
 
-  std::size_t capacity() { return capacity_; }
+  std::size_t capacity() const noexcept { return capacity_; }
+
+  allocator_type get_allocator() const noexcept { return alloc_; }
 
-  const T& operator[](std::size_t index) const { return data[index]; }
-  T& operator[](std::size_t index) { return data[index]; }
+  const T& operator[](std::size_t index) const { return data_[index]; }
+  T& operator[](std::size_t index) { return data_[index]; }
 
   void resize(std::size_t new_size)
   {
-    if (capacity_ == new_size) {
+    if (new_size < size_) {
+      destroy(data_ + new_size, data_ + size_);
+      size_ = new_size;
       return;
     }
 
-    std::size_t old_capacity = capacity_;
-    reallocate(new_size);
-    size_ = new_size;
+    reserve(new_size);
+    for (; size_ < new_size; size_++) {
+      alloc_traits::construct(alloc_, data_ + size_);
+    }
+  }
 
-    if (old_capacity < new_size) {
-      for (std::size_t i = old_capacity; i < new_size; i++) {
-        data[i] = T {};
+  // Like resize, but trivially default constructible elements are left
+  // uninitialized instead of zeroed, so the vector can be handed straight to
+  // a read() or recv() that overwrites them. Other elements, and those of
+  // allocators with their own construct, are value-initialized as by resize.
+  void resize_for_overwrite(std::size_t new_size)
+  {
+    if constexpr (skips_default_init) {
+      if (new_size < size_) {
+        destroy(data_ + new_size, data_ + size_);
+      } else {
+        reserve(new_size);
       }
+      size_ = new_size;
+    } else {
+      resize(new_size);
     }
   }
 
-  void push_back(T&& element)
+  template<typename... Args>
+  T& emplace_back(Args&&... args)
   {
     if (size_ == capacity_) {
-      reallocate(capacity_ * 2);
+      // args may refer into this vector, so build the element before the
+      // buffer moves
+      T element(std::forward<Args>(args)...);
+      grow();
+      alloc_traits::construct(alloc_, data_ + size_, std::move(element));
+    } else {
+      alloc_traits::construct(
+          alloc_, data_ + size_, std::forward<Args>(args)...);
     }
-    data[size_++] = element;
+    return data_[size_++];
   }
 
+  void push_back(const T& element) { emplace_back(element); }
+  void push_back(T&& element) { emplace_back(std::move(element)); }
+
   void pop_back()
   {
     if (size_ == 0) {
       throw std::runtime_error("Unable to pop vector with 0 elements");
     }
     size_--;
+    alloc_traits::destroy(alloc_, data_ + size_);
   }
 
-  Iterator insert(Iterator it, T&& element)
+  template<typename... Args>
+  Iterator emplace(Iterator it, Args&&... args)
   {
-    if (size_ + 1 == capacity_) {
-      reallocate(capacity_ * 2);
+    auto index = static_cast<std::size_t>(it - begin());
+    if (index == size_) {
+      emplace_back(std::forward<Args>(args)...);
+    } else {
+      insert_at(index, T(std::forward<Args>(args)...));
     }
+    return begin() + static_cast<std::ptrdiff_t>(index);
+  }
 
-    std::copy_backward(it,
-                       begin() + static_cast<std::ptrdiff_t>(size_),
-                       begin() + static_cast<std::ptrdiff_t>(size_) + 1);
-    *it = element;
-    ++size_;
-    return it;
+  Iterator insert(Iterator it, const T& element)
+  {
+    return emplace(it, element);
+  }
+
+  Iterator insert(Iterator it, T&& element)
+  {
+    auto index = static_cast<std::size_t>(it - begin());
+    insert_at(index, std::move(element));
+    return begin() + static_cast<std::ptrdiff_t>(index);
   }
 
-  vector(std::initializer_list<T> elements)
-      : size_(elements.size())
-      , capacity_(elements.size())
-      , data(new T[elements.size()])
+  // Inserts [first, last), which must not point into this vector. Forward
+  // iterators reserve once and construct in place.
+  template<std::input_iterator InputIt>
+  Iterator insert(Iterator it, InputIt first, InputIt last)
   {
-    size_t i = 0;
-    for (auto it = elements.begin(); it != elements.end(); it++) {
-      data[i++] = *it;
+    auto index = static_cast<std::size_t>(it - begin());
+    if constexpr (std::forward_iterator<InputIt>) {
+      insert_counted(
+          index, first, static_cast<std::size_t>(std::distance(first, last)));
+    } else {
+      insert_input(index, std::move(first), last);
     }
+    return begin() + static_cast<std::ptrdiff_t>(index);
   }
 
-  explicit vector(std::size_t initial_size) noexcept
-      : size_(initial_size)
-      , capacity_(initial_size)
-      , data(new T[initial_size])
+  // Range counterparts of the above, with the same restriction
+  template<std::ranges::input_range Range>
+  Iterator insert_range(Iterator it, Range&& range)
   {
-    for (T* ptr = data; ptr < data + initial_size; ptr++) {
-      data[ptr] = {};
+    auto index = static_cast<std::size_t>(it - begin());
+    if constexpr (std::ranges::forward_range<Range>
+                  || std::ranges::sized_range<Range>)
+    {
+      insert_counted(index,
+                     std::ranges::begin(range),
+                     static_cast<std::size_t>(std::ranges::distance(range)));
+    } else {
+      insert_input(index, std::ranges::begin(range), std::ranges::end(range));
     }
+    return begin() + static_cast<std::ptrdiff_t>(index);
   }
 
-  explicit vector(std::size_t initial_size, T&& initial_element) noexcept
-      : vector(initial_size)
+  template<std::ranges::input_range Range>
+  void append_range(Range&& range)
+  {
+    insert_range(end(), std::forward<Range>(range));
+  }
+
+  vector(std::initializer_list<T> elements,
+         const Allocator& alloc = Allocator())
+      : size_(0)
+      , capacity_(0)
+      , data_(nullptr)
+      , alloc_(alloc)
   {
-    for (T* ptr = data; ptr < data + initial_size; ptr++) {
-      data[ptr] = initial_element;
+    reserve(elements.size());
+    for (const T& element : elements) {
+      alloc_traits::construct(alloc_, data_ + size_, element);
+      ++size_;
     }
   }
 
+  explicit vector(std::size_t initial_size,
+                  const Allocator& alloc = Allocator())
+      : size_(0)
+      , capacity_(0)
+      , data_(nullptr)
+      , alloc_(alloc)
+  {
+    reserve(initial_size);
+    for (; size_ < initial_size; size_++) {
+      alloc_traits::construct(alloc_, data_ + size_);
+    }
+  }
+
+  // Sized like the above, with elements initialized as by
+  // resize_for_overwrite
+  vector(std::size_t initial_size,
+         for_overwrite_t,
+         const Allocator& alloc = Allocator())
+      : size_(0)
+      , capacity_(0)
+      , data_(nullptr)
+      , alloc_(alloc)
+  {
+    resize_for_overwrite(initial_size);
+  }
+
+  explicit vector(std::size_t initial_size,
+                  const T& initial_element,
+                  const Allocator& alloc = Allocator())
+      : size_(0)
+      , capacity_(0)
+      , data_(nullptr)
+      , alloc_(alloc)
+  {
+    fill_empty(initial_size, initial_element);
+  }
+
   vector(vector&& other) noexcept
-      : size_(other.size)
-      , capacity_(other.capacity)
-      , data(other.data)
+      : size_(other.size_)
+      , capacity_(other.capacity_)
+      , data_(other.data_)
+      , alloc_(std::move(other.alloc_))
   {
     other.size_ = 0;
     other.capacity_ = 0;
-    other.data = nullptr;
+    other.data_ = nullptr;
   }
 
-  vector(const vector& other) noexcept
-      : size_(other.size_)
-      , capacity_(other.capacity_)
-      , data(new T[other.capacity_])
+  vector(const vector& other)
+      : size_(0)
+      , capacity_(0)
+      , data_(nullptr)
+      , alloc_(alloc_traits::select_on_container_copy_construction(
+            other.alloc_))
   {
-    memcpy(data, other.data, capacity_);
+    copy_from(other);
   }
 
-  vector& operator=(vector&& other) noexcept
+  vector& operator=(vector&& other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value
+      || alloc_traits::is_always_equal::value)
   {
-    if (this != &other) {
+    if (this == &other) {
+      return *this;
+    }
+
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value
+                  || alloc_traits::is_always_equal::value)
+    {
+      release();
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                        value) {
+        alloc_ = std::move(other.alloc_);
+      }
       size_ = other.size_;
       capacity_ = other.capacity_;
-      data = other.data;
+      data_ = other.data_;
 
       other.size_ = 0;
       other.capacity_ = 0;
-      other.data = nullptr;
+      other.data_ = nullptr;
+    } else if (alloc_ == other.alloc_) {
+      release();
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+      std::swap(data_, other.data_);
+    } else {
+      // Storage can't change hands, so move the elements one by one
+      clear();
+      if (capacity_ < other.size_) {
+        reallocate(other.size_);
+      }
+      for (; size_ < other.size_; size_++) {
+        alloc_traits::construct(
+            alloc_, data_ + size_, std::move(other.data_[size_]));
+      }
+      other.clear();
     }
 
     return *this;
   }
 
-  vector& operator=(const vector& other) noexcept
+  vector& operator=(const vector& other)
   {
-    if (this != &other) {
-      size_ = other.size_;
-      capacity_ = other.capacity_;
-      data = new T[capacity_];
-      memcpy(data, other.data, other.capacity);
+    if (this == &other) {
+      return *this;
+    }
+
+    clear();
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+    {
+      if (alloc_ != other.alloc_) {
+        release();
+      }
+      alloc_ = other.alloc_;
     }
+    copy_from(other);
 
     return *this;
   }
 
-  Iterator begin() { return data; }
-  Iterator end() { return data + capacity_; }
+  Iterator begin() { return data_; }
+  Iterator end() { return data_ + size_; }
 
   T& at(std::size_t idx)
   {
-    if (idx >= capacity_) {
+    if (idx >= size_) {
       throw std::out_of_range("Index out of bounds");
     }
-    return data[idx];
+    return data_[idx];
   }
 
-  T& front() { return data[0]; }
-  T& back() { return data[size_ - 1]; }
+  T& front() { return data_[0]; }
+  T& back() { return data_[size_ - 1]; }
+
+  T* data() noexcept { return data_; }
+  const T* data() const noexcept { return data_; }
 
   bool empty() const noexcept { return size_ == 0; }
-  void clear() { size_ = 0; }
+
+  void clear() noexcept
+  {
+    destroy(data_, data_ + size_);
+    size_ = 0;
+  }
 
   std::size_t size() const { return size_; }
 
-  ~vector() { delete[] data; }
+  ~vector() { release(); }
 
   void assign(std::size_t size, const T& element)
   {
-    if (size > capacity_) {
-      reallocate(size);
-    }
-    for (std::size_t i = 0; i < size; i++) {
-      data[i] = element;
-    }
-    size_ = size;
+    clear();
+    fill_empty(size, element);
   }
 
   void reserve(std::size_t new_capacity)
@@ -283,7 +632,6 @@ public:
     if (capacity_ < new_capacity) {
       reallocate(new_capacity);
     }
-    capacity_ = new_capacity;
   }
 
   void shrink_to_fit()
@@ -293,37 +641,60 @@ public:
     }
   }
 
-  std::strong_ordering operator<=>(const steev::vector<T>& other) const noexcept
+  std::strong_ordering operator<=>(const vector& other) const noexcept
   {
     if (size_ != other.size_) {
       return size_ <=> other.size_;
     }
 
-    for (std::size_t i = 0; i < size_; i++) {
-      if (data[i] != other.data[i]) {
-        return data[i] <=> other.data[i];
-      }
+    std::size_t index = simd::mismatch(data_, other.data_, size_);
+    if (index == size_) {
+      return std::strong_ordering::equal;
     }
+    return data_[index] <=> other.data_[index];
+  }
+
+  bool operator==(const vector& other) const noexcept
+  {
+    return size_ == other.size_ && simd::equal(data_, other.data_, size_);
+  }
 
-    return std::strong_ordering::equal;
+  // Position of the first element equal to value, or end()
+  friend Iterator find(vector& vec, const T& value)
+  {
+    return vec.data_ + simd::find(vec.data_, vec.size_, value);
   }
 
-  bool operator==(const steev::vector<T>& other) const noexcept
+  friend std::size_t count(const vector& vec, const T& value)
   {
-    return *this <=> other == std::strong_ordering::equal;
+    return simd::count(vec.data_, vec.size_, value);
   }
 
-  void swap(steev::vector<T>& other) noexcept
+  void swap(vector& other) noexcept
   {
-    std::swap(data, other.data);
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
+    std::swap(data_, other.data_);
     std::swap(size_, other.size_);
     std::swap(capacity_, other.capacity_);
   }
 
   Iterator erase(Iterator it)
   {
-    std::copy(it + 1, end(), it);
-    --size_;
+    if constexpr (bitwise_relocatable) {
+      T* pos = &*it;
+      alloc_traits::destroy(alloc_, pos);
+      std::memmove(static_cast<void*>(pos),
+                   static_cast<const void*>(pos + 1),
+                   static_cast<std::size_t>(data_ + size_ - pos - 1)
+                       * sizeof(T));
+      --size_;
+    } else {
+      std::move(it + 1, end(), it);
+      --size_;
+      alloc_traits::destroy(alloc_, data_ + size_);
+    }
     return it;
   }
 };
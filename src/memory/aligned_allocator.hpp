@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#include "memory/allocator_traits.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <sys/mman.h>
+#  define STEEV_HAS_MMAP
+#endif
+
+namespace steev
+{
+// Cache line size on the x86-64 and most AArch64 parts we run on
+inline constexpr std::size_t cache_line_size = 64;
+
+// Transparent huge page size on x86-64
+inline constexpr std::size_t huge_page_size = std::size_t {2} << 20;
+
+// Allocator for buffers that are scanned with vector loads or indexed at
+// random. Every block starts on an Alignment boundary, taken from
+// posix_memalign. Blocks of at least HugePageThreshold bytes are mapped
+// directly instead, aligned and rounded up to whole huge pages and marked
+// MADV_HUGEPAGE, so a big table costs a handful of TLB entries instead of
+// one per 4 KiB. A threshold of zero turns the mapping off. Without mmap
+// both fall back to aligned operator new.
+template<typename T,
+         std::size_t Alignment = cache_line_size,
+         std::size_t HugePageThreshold = huge_page_size>
+class aligned_allocator
+{
+  static_assert(std::has_single_bit(Alignment),
+                "Alignment has to be a power of two");
+
+  static constexpr std::size_t alignment = std::max(Alignment, alignof(T));
+
+  static constexpr bool maps(std::size_t count) noexcept
+  {
+#ifdef STEEV_HAS_MMAP
+    return HugePageThreshold != 0 && count * sizeof(T) >= HugePageThreshold;
+#else
+    static_cast<void>(count);
+    return false;
+#endif
+  }
+
+  static std::size_t mapped_bytes(std::size_t count) noexcept
+  {
+    return (count * sizeof(T) + huge_page_size - 1) / huge_page_size
+        * huge_page_size;
+  }
+
+#ifdef STEEV_HAS_MMAP
+  // Over-maps by a huge page and trims both ends, since mmap only promises
+  // page alignment and a huge page has to start on its own boundary
+  static void* map(std::size_t bytes)
+  {
+    std::size_t padded = bytes + huge_page_size;
+    void* mapping = ::mmap(nullptr,
+                           padded,
+                           PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS,
+                           -1,
+                           0);
+    if (mapping == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+
+    auto start = reinterpret_cast<std::uintptr_t>(mapping);
+    auto aligned = (start + huge_page_size - 1) & ~(huge_page_size - 1);
+    std::size_t head = aligned - start;
+    if (head != 0) {
+      ::munmap(mapping, head);
+    }
+    if (padded - head != bytes) {
+      ::munmap(reinterpret_cast<void*>(aligned + bytes),
+               padded - head - bytes);
+    }
+
+    void* result = reinterpret_cast<void*>(aligned);
+#  ifdef MADV_HUGEPAGE
+    // Only a hint; without transparent huge pages the mapping still works
+    ::madvise(result, bytes, MADV_HUGEPAGE);
+#  endif
+    return result;
+  }
+#endif
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = std::true_type;
+
+  template<typename U>
+  struct rebind
+  {
+    using other = aligned_allocator<U, Alignment, HugePageThreshold>;
+  };
+
+  constexpr aligned_allocator() noexcept = default;
+
+  template<typename U>
+  constexpr aligned_allocator(
+      const aligned_allocator<U, Alignment, HugePageThreshold>&) noexcept
+  {
+  }
+
+  [[nodiscard]] T* allocate(std::size_t count)
+  {
+    if (count > max_size()) {
+      throw std::bad_array_new_length();
+    }
+
+#ifdef STEEV_HAS_MMAP
+    if (maps(count)) {
+      return static_cast<T*>(map(mapped_bytes(count)));
+    }
+
+    // posix_memalign wants at least pointer alignment
+    std::size_t align = std::max(alignment, sizeof(void*));
+    std::size_t bytes = std::max<std::size_t>(count, 1) * sizeof(T);
+    void* ptr = nullptr;
+    if (::posix_memalign(&ptr, align, bytes) != 0) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(ptr);
+#else
+    return static_cast<T*>(::operator new(
+        count * sizeof(T), static_cast<std::align_val_t>(alignment)));
+#endif
+  }
+
+  // Mapped blocks hand back the rest of their last huge page
+  [[nodiscard]] allocation_result<T*> allocate_at_least(std::size_t count)
+  {
+    T* ptr = allocate(count);
+    if (maps(count)) {
+      count = mapped_bytes(count) / sizeof(T);
+    }
+    return {ptr, count};
+  }
+
+  void deallocate(T* ptr, std::size_t count) noexcept
+  {
+#ifdef STEEV_HAS_MMAP
+    if (maps(count)) {
+      ::munmap(ptr, mapped_bytes(count));
+    } else {
+      std::free(ptr);
+    }
+#else
+    ::operator delete(
+        ptr, count * sizeof(T), static_cast<std::align_val_t>(alignment));
+#endif
+  }
+
+  constexpr std::size_t max_size() const noexcept
+  {
+    return std::numeric_limits<std::size_t>::max() / sizeof(T);
+  }
+
+  template<typename U>
+  constexpr bool operator==(
+      const aligned_allocator<U, Alignment, HugePageThreshold>&) const noexcept
+  {
+    return true;
+  }
+};
+}  // namespace steev
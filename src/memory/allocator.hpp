@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#include "memory/allocator_traits.hpp"
+#include "memory/relocate.hpp"
+
+#if defined(__GLIBC__)
+#  include <malloc.h>
+#endif
+
+namespace steev
+{
+template<typename T>
+class allocator
+{
+  static constexpr bool over_aligned =
+      alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = std::true_type;
+
+  constexpr allocator() noexcept = default;
+
+  template<typename U>
+  constexpr allocator(const allocator<U>&) noexcept
+  {
+  }
+
+  [[nodiscard]] T* allocate(std::size_t count)
+  {
+    if (count > max_size()) {
+      throw std::bad_array_new_length();
+    }
+
+    if constexpr (over_aligned) {
+      return static_cast<T*>(::operator new(
+          count * sizeof(T), static_cast<std::align_val_t>(alignof(T))));
+    } else {
+      void* ptr = std::malloc(count * sizeof(T));
+      if (ptr == nullptr && count != 0) {
+        throw std::bad_alloc();
+      }
+      return static_cast<T*>(ptr);
+    }
+  }
+
+  // Reports the slack malloc rounded the block up to, where glibc can tell
+  [[nodiscard]] allocation_result<T*> allocate_at_least(std::size_t count)
+  {
+    T* ptr = allocate(count);
+#if defined(__GLIBC__)
+    if constexpr (!over_aligned) {
+      if (ptr != nullptr) {
+        count = malloc_usable_size(ptr) / sizeof(T);
+      }
+    }
+#endif
+    return {ptr, count};
+  }
+
+  void deallocate(T* ptr, std::size_t count) noexcept
+  {
+    if constexpr (over_aligned) {
+      ::operator delete(ptr,
+                        count * sizeof(T),
+                        static_cast<std::align_val_t>(alignof(T)));
+    } else {
+      std::free(ptr);
+    }
+  }
+
+  // realloc carries the bytes over, so T has to survive a bitwise move
+  [[nodiscard]] T* reallocate(T* ptr, std::size_t, std::size_t new_count)
+    requires(!over_aligned && is_trivially_relocatable_v<T>)
+  {
+    if (new_count > max_size()) {
+      throw std::bad_array_new_length();
+    }
+
+    void* new_ptr =
+        std::realloc(static_cast<void*>(ptr), new_count * sizeof(T));
+    if (new_ptr == nullptr && new_count != 0) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(new_ptr);
+  }
+
+  // reallocate, reporting the slack like allocate_at_least
+  [[nodiscard]] allocation_result<T*> reallocate_at_least(
+      T* ptr, std::size_t old_count, std::size_t new_count)
+    requires(!over_aligned && is_trivially_relocatable_v<T>)
+  {
+    T* new_ptr = reallocate(ptr, old_count, new_count);
+#if defined(__GLIBC__)
+    if (new_ptr != nullptr) {
+      new_count = malloc_usable_size(new_ptr) / sizeof(T);
+    }
+#endif
+    return {new_ptr, new_count};
+  }
+
+  constexpr std::size_t max_size() const noexcept
+  {
+    return std::numeric_limits<std::size_t>::max() / sizeof(T);
+  }
+
+  template<typename U>
+  constexpr bool operator==(const allocator<U>&) const noexcept
+  {
+    return true;
+  }
+};
+}  // namespace steev
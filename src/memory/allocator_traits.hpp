@@ -0,0 +1,210 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "memory/pointer_traits.hpp"
+
+namespace steev
+{
+// What allocate_at_least hands back: the block and how many elements it
+// really holds, which may be more than were asked for
+template<typename Pointer>
+struct allocation_result
+{
+  Pointer ptr;
+  std::size_t count;
+};
+
+namespace detail
+{
+template<typename Alloc>
+struct allocator_pointer
+{
+  using type = typename Alloc::value_type*;
+};
+
+template<typename Alloc>
+  requires requires { typename Alloc::pointer; }
+struct allocator_pointer<Alloc>
+{
+  using type = typename Alloc::pointer;
+};
+
+// Allocators with non-type template parameters have to say how to rebind
+template<typename Alloc, typename U>
+struct allocator_rebind
+{
+  using type = typename Alloc::template rebind<U>::other;
+};
+
+template<template<typename, typename...> class Alloc,
+         typename T,
+         typename... Args,
+         typename U>
+struct allocator_rebind<Alloc<T, Args...>, U>
+{
+  using type = Alloc<U, Args...>;
+};
+
+template<template<typename, typename...> class Alloc,
+         typename T,
+         typename... Args,
+         typename U>
+  requires requires {
+    typename Alloc<T, Args...>::template rebind<U>::other;
+  }
+struct allocator_rebind<Alloc<T, Args...>, U>
+{
+  using type = typename Alloc<T, Args...>::template rebind<U>::other;
+};
+
+template<typename Alloc>
+struct allocator_is_always_equal : std::is_empty<Alloc>
+{
+};
+
+template<typename Alloc>
+  requires requires { typename Alloc::is_always_equal; }
+struct allocator_is_always_equal<Alloc> : Alloc::is_always_equal
+{
+};
+}  // namespace detail
+
+template<typename Alloc>
+struct allocator_traits
+{
+  using allocator_type = Alloc;
+  using value_type = typename Alloc::value_type;
+  using pointer = typename detail::allocator_pointer<Alloc>::type;
+  using const_pointer =
+      typename pointer_traits<pointer>::template rebind<const value_type>;
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+
+  using propagate_on_container_copy_assignment = std::bool_constant<
+      requires {
+        requires Alloc::propagate_on_container_copy_assignment::value;
+      }>;
+  using propagate_on_container_move_assignment = std::bool_constant<
+      requires {
+        requires Alloc::propagate_on_container_move_assignment::value;
+      }>;
+  using propagate_on_container_swap = std::bool_constant<
+      requires { requires Alloc::propagate_on_container_swap::value; }>;
+  using is_always_equal = detail::allocator_is_always_equal<Alloc>;
+
+  template<typename U>
+  using rebind_alloc = typename detail::allocator_rebind<Alloc, U>::type;
+
+  template<typename U>
+  using rebind_traits = allocator_traits<rebind_alloc<U>>;
+
+  [[nodiscard]] static pointer allocate(Alloc& alloc, size_type count)
+  {
+    return alloc.allocate(count);
+  }
+
+  // Falls back to allocate when the allocator can't report spare room.
+  // The block must be deallocated with the returned count.
+  [[nodiscard]] static allocation_result<pointer> allocate_at_least(
+      Alloc& alloc, size_type count)
+  {
+    if constexpr (requires { alloc.allocate_at_least(count); }) {
+      return alloc.allocate_at_least(count);
+    } else {
+      return {alloc.allocate(count), count};
+    }
+  }
+
+  static void deallocate(Alloc& alloc, pointer ptr, size_type count) noexcept
+  {
+    alloc.deallocate(ptr, count);
+  }
+
+  template<typename U, typename... Args>
+  static void construct(Alloc& alloc, U* ptr, Args&&... args)
+  {
+    if constexpr (requires {
+                    alloc.construct(ptr, std::forward<Args>(args)...);
+                  })
+    {
+      alloc.construct(ptr, std::forward<Args>(args)...);
+    } else {
+      std::construct_at(ptr, std::forward<Args>(args)...);
+    }
+  }
+
+  template<typename U>
+  static void destroy(Alloc& alloc, U* ptr) noexcept
+  {
+    if constexpr (requires { alloc.destroy(ptr); }) {
+      alloc.destroy(ptr);
+    } else {
+      std::destroy_at(ptr);
+    }
+  }
+
+  // True when construct/destroy for U are the plain placement new and
+  // destructor call, so containers may move objects of U around bytewise
+  template<typename U>
+  static constexpr bool uses_default_construct =
+      !requires(Alloc& alloc, U* ptr) { alloc.destroy(ptr); }
+      && !requires(Alloc& alloc, U* ptr, U&& value) {
+           alloc.construct(ptr, std::move(value));
+         };
+
+  // Extension: allocators may resize a block realloc-style, carrying its
+  // bytes over to the new location when it can't grow in place
+  static constexpr bool has_reallocate =
+      requires(Alloc& alloc, pointer ptr, size_type count) {
+        alloc.reallocate(ptr, count, count);
+      };
+
+  [[nodiscard]] static pointer reallocate(Alloc& alloc,
+                                          pointer ptr,
+                                          size_type old_count,
+                                          size_type new_count)
+    requires has_reallocate
+  {
+    return alloc.reallocate(ptr, old_count, new_count);
+  }
+
+  // Falls back to reallocate when the allocator can't report spare room
+  [[nodiscard]] static allocation_result<pointer> reallocate_at_least(
+      Alloc& alloc, pointer ptr, size_type old_count, size_type new_count)
+    requires has_reallocate
+  {
+    if constexpr (requires {
+                    alloc.reallocate_at_least(ptr, old_count, new_count);
+                  })
+    {
+      return alloc.reallocate_at_least(ptr, old_count, new_count);
+    } else {
+      return {alloc.reallocate(ptr, old_count, new_count), new_count};
+    }
+  }
+
+  static size_type max_size(const Alloc& alloc) noexcept
+  {
+    if constexpr (requires { alloc.max_size(); }) {
+      return alloc.max_size();
+    } else {
+      return std::numeric_limits<size_type>::max() / sizeof(value_type);
+    }
+  }
+
+  static Alloc select_on_container_copy_construction(const Alloc& alloc)
+  {
+    if constexpr (requires { alloc.select_on_container_copy_construction(); })
+    {
+      return alloc.select_on_container_copy_construction();
+    } else {
+      return alloc;
+    }
+  }
+};
+}  // namespace steev
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
+#include "memory/allocator_traits.hpp"
+
 namespace steev
 {
 template<typename T>
@@ -38,7 +41,38 @@ public:
   void operator()(T* ptr) const
   {
     static_assert(sizeof(T) != 0, "Can't delete pointer to incomplete type");
-    delete ptr;
+    delete[] ptr;
+  }
+};
+
+// Deleter for arrays from allocate_unique: destroys the elements and gives
+// the block back to the allocator it came from, which may need its size
+template<typename Allocator>
+class allocator_delete
+{
+  using alloc_traits = allocator_traits<Allocator>;
+  using T = typename alloc_traits::value_type;
+
+  [[no_unique_address]] Allocator alloc_ {};
+  std::size_t count_ = 0;
+
+public:
+  allocator_delete() = default;
+
+  allocator_delete(const Allocator& alloc, std::size_t count) noexcept
+      : alloc_(alloc)
+      , count_(count)
+  {
+  }
+
+  std::size_t size() const noexcept { return count_; }
+
+  void operator()(T* ptr)
+  {
+    for (std::size_t i = count_; i-- > 0;) {
+      alloc_traits::destroy(alloc_, ptr + i);
+    }
+    alloc_traits::deallocate(alloc_, ptr, count_);
   }
 };
 }  // namespace steev
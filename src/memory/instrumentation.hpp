@@ -0,0 +1,203 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <source_location>
+#include <string_view>
+#include <vector>
+
+// Opt-in allocation accounting for steev containers and smart pointers.
+// Build with STEEV_INSTRUMENT_ALLOCATIONS defined (the CMake option
+// stdlib_INSTRUMENT_ALLOCATIONS does that) to have them report every
+// allocation, deallocation and reallocation under the type that made it.
+// Without it the hooks are empty and compile away, and snapshot() stays
+// empty.
+
+namespace steev::instrumentation
+{
+#ifdef STEEV_INSTRUMENT_ALLOCATIONS
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+struct counters
+{
+  uint64_t allocations = 0;
+  uint64_t deallocations = 0;
+  uint64_t bytes_allocated = 0;
+  uint64_t reallocations = 0;
+};
+
+struct entry
+{
+  std::string_view type;
+  counters counts;
+  bool allocation_only = false;
+};
+
+// Reports under allocation_only<Owner> are for memory freed somewhere that
+// can't tell it apart from memory nobody counted, like the delete behind
+// make_unique. Only allocations are kept there, so the dump doesn't set them
+// against deallocations.
+template<typename Owner>
+struct allocation_only
+{
+};
+
+namespace detail
+{
+template<typename T>
+std::string_view type_name()
+{
+  // GCC and Clang both spell the template argument out as "T = ..."
+  std::string_view name = std::source_location::current().function_name();
+  std::size_t start = name.find("T = ");
+  if (start == std::string_view::npos) {
+    return name;
+  }
+  start += 4;
+  std::size_t end = name.find(';', start);
+  if (end == std::string_view::npos) {
+    end = name.rfind(']');
+  }
+  return name.substr(start, end - start);
+}
+
+// One per reporting type, linked into a list that is only ever pushed to
+struct site
+{
+  std::string_view type;
+  std::atomic<uint64_t> allocations {0};
+  std::atomic<uint64_t> deallocations {0};
+  std::atomic<uint64_t> bytes_allocated {0};
+  std::atomic<uint64_t> reallocations {0};
+  bool allocation_only = false;
+  site* next = nullptr;
+
+  site(std::string_view name, bool only_allocations);
+};
+
+inline std::atomic<site*> sites {nullptr};
+
+inline site::site(std::string_view name, bool only_allocations)
+    : type(name)
+    , allocation_only(only_allocations)
+    , next(sites.load(std::memory_order_relaxed))
+{
+  while (!sites.compare_exchange_weak(
+      next, this, std::memory_order_release, std::memory_order_relaxed))
+  {
+  }
+}
+
+template<typename Owner>
+inline constexpr bool is_allocation_only = false;
+
+template<typename Owner>
+inline constexpr bool is_allocation_only<allocation_only<Owner>> = true;
+
+template<typename Owner>
+site& site_for()
+{
+  static site instance(type_name<Owner>(), is_allocation_only<Owner>);
+  return instance;
+}
+}  // namespace detail
+
+// Hooks called by the containers and smart pointers. Owner is the type the
+// numbers are reported under.
+template<typename Owner>
+void on_allocate([[maybe_unused]] std::size_t bytes) noexcept
+{
+  if constexpr (enabled) {
+    detail::site& site = detail::site_for<Owner>();
+    site.allocations.fetch_add(1, std::memory_order_relaxed);
+    site.bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+  }
+}
+
+template<typename Owner>
+void on_deallocate() noexcept
+{
+  static_assert(!detail::is_allocation_only<Owner>,
+                "allocation_only sites don't see deallocations");
+  if constexpr (enabled) {
+    detail::site_for<Owner>().deallocations.fetch_add(
+        1, std::memory_order_relaxed);
+  }
+}
+
+// Existing elements had to move to a buffer of a different capacity
+template<typename Owner>
+void on_reallocate() noexcept
+{
+  if constexpr (enabled) {
+    detail::site_for<Owner>().reallocations.fetch_add(
+        1, std::memory_order_relaxed);
+  }
+}
+
+// Counters of every type that has reported so far, newest first
+inline std::vector<entry> snapshot()
+{
+  std::vector<entry> entries;
+  for (detail::site* site = detail::sites.load(std::memory_order_acquire);
+       site != nullptr;
+       site = site->next)
+  {
+    entries.push_back(
+        {site->type,
+         {site->allocations.load(std::memory_order_relaxed),
+          site->deallocations.load(std::memory_order_relaxed),
+          site->bytes_allocated.load(std::memory_order_relaxed),
+          site->reallocations.load(std::memory_order_relaxed)},
+         site->allocation_only});
+  }
+  return entries;
+}
+
+// Looks up a single type's counters; all zero if it hasn't reported
+template<typename Owner>
+counters counters_for()
+{
+  std::string_view type = detail::type_name<Owner>();
+  for (const entry& entry : snapshot()) {
+    if (entry.type == type) {
+      return entry.counts;
+    }
+  }
+  return {};
+}
+
+inline void dump(std::ostream& out)
+{
+  for (const entry& entry : snapshot()) {
+    out << entry.type << ": " << entry.counts.allocations << " allocations, ";
+    if (entry.allocation_only) {
+      out << entry.counts.bytes_allocated
+          << " bytes (deallocations not tracked)\n";
+      continue;
+    }
+    out << entry.counts.deallocations << " deallocations, "
+        << entry.counts.bytes_allocated << " bytes, "
+        << entry.counts.reallocations << " reallocations\n";
+  }
+}
+
+// Zeroes every counter; types stay registered
+inline void reset() noexcept
+{
+  for (detail::site* site = detail::sites.load(std::memory_order_acquire);
+       site != nullptr;
+       site = site->next)
+  {
+    site->allocations.store(0, std::memory_order_relaxed);
+    site->deallocations.store(0, std::memory_order_relaxed);
+    site->bytes_allocated.store(0, std::memory_order_relaxed);
+    site->reallocations.store(0, std::memory_order_relaxed);
+  }
+}
+}  // namespace steev::instrumentation
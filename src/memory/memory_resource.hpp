@@ -0,0 +1,207 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace steev
+{
+// Type-erased source of raw memory, as in <memory_resource>. Derived classes
+// implement the do_ functions; callers go through the public ones.
+class memory_resource
+{
+  static constexpr std::size_t max_align = alignof(std::max_align_t);
+
+public:
+  memory_resource() = default;
+  memory_resource(const memory_resource&) = default;
+  memory_resource& operator=(const memory_resource&) = default;
+  virtual ~memory_resource() = default;
+
+  [[nodiscard]] void* allocate(std::size_t bytes,
+                               std::size_t alignment = max_align)
+  {
+    return do_allocate(bytes, alignment);
+  }
+
+  void deallocate(void* ptr,
+                  std::size_t bytes,
+                  std::size_t alignment = max_align) noexcept
+  {
+    do_deallocate(ptr, bytes, alignment);
+  }
+
+  // Whether memory from one resource can be returned to the other
+  bool is_equal(const memory_resource& other) const noexcept
+  {
+    return do_is_equal(other);
+  }
+
+  friend bool operator==(const memory_resource& lhs,
+                         const memory_resource& rhs) noexcept
+  {
+    return &lhs == &rhs || lhs.is_equal(rhs);
+  }
+
+protected:
+  virtual void* do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+  virtual void do_deallocate(void* ptr,
+                             std::size_t bytes,
+                             std::size_t alignment) noexcept = 0;
+  virtual bool do_is_equal(const memory_resource& other) const noexcept = 0;
+};
+
+namespace detail
+{
+class new_delete_resource final : public memory_resource
+{
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      return ::operator new(bytes, std::align_val_t {alignment});
+    }
+    return ::operator new(bytes);
+  }
+
+  void do_deallocate(void* ptr,
+                     std::size_t bytes,
+                     std::size_t alignment) noexcept override
+  {
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      ::operator delete(ptr, bytes, std::align_val_t {alignment});
+    } else {
+      ::operator delete(ptr, bytes);
+    }
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+
+class null_resource final : public memory_resource
+{
+  void* do_allocate(std::size_t, std::size_t) override
+  {
+    throw std::bad_alloc();
+  }
+
+  void do_deallocate(void*, std::size_t, std::size_t) noexcept override {}
+
+  bool do_is_equal(const memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+}  // namespace detail
+
+// Global operator new and delete
+inline memory_resource* new_delete_resource() noexcept
+{
+  // Never destroyed, so it outlives anything that allocated from it
+  static auto* instance = new detail::new_delete_resource;
+  return instance;
+}
+
+// Throws std::bad_alloc on every allocation; useful as an upstream that
+// forbids falling back to the heap
+inline memory_resource* null_memory_resource() noexcept
+{
+  static auto* instance = new detail::null_resource;
+  return instance;
+}
+
+namespace detail
+{
+inline std::atomic<memory_resource*>& default_resource() noexcept
+{
+  static std::atomic<memory_resource*> resource {steev::new_delete_resource()};
+  return resource;
+}
+}  // namespace detail
+
+inline memory_resource* get_default_resource() noexcept
+{
+  return detail::default_resource().load(std::memory_order_acquire);
+}
+
+// Passing nullptr restores new_delete_resource(); returns the previous one
+inline memory_resource* set_default_resource(
+    memory_resource* resource) noexcept
+{
+  if (resource == nullptr) {
+    resource = new_delete_resource();
+  }
+  return detail::default_resource().exchange(resource,
+                                             std::memory_order_acq_rel);
+}
+
+// Allocator that hands every request to a memory_resource, so containers
+// with different resources still have the same type. Like std's, it does
+// not propagate on copy, move or swap, and container copies fall back to
+// the default resource.
+template<typename T = std::byte>
+class polymorphic_allocator
+{
+  memory_resource* resource_;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  polymorphic_allocator() noexcept
+      : resource_(get_default_resource())
+  {
+  }
+
+  polymorphic_allocator(memory_resource* resource) noexcept
+      : resource_(resource)
+  {
+  }
+
+  template<typename U>
+  polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept
+      : resource_(other.resource())
+  {
+  }
+
+  polymorphic_allocator& operator=(const polymorphic_allocator&) = delete;
+  polymorphic_allocator(const polymorphic_allocator&) = default;
+
+  [[nodiscard]] T* allocate(std::size_t count)
+  {
+    if (count > max_size()) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(
+        resource_->allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t count) noexcept
+  {
+    resource_->deallocate(ptr, count * sizeof(T), alignof(T));
+  }
+
+  std::size_t max_size() const noexcept
+  {
+    return std::numeric_limits<std::size_t>::max() / sizeof(T);
+  }
+
+  polymorphic_allocator select_on_container_copy_construction() const
+  {
+    return polymorphic_allocator();
+  }
+
+  memory_resource* resource() const noexcept { return resource_; }
+
+  template<typename U>
+  friend bool operator==(const polymorphic_allocator& lhs,
+                         const polymorphic_allocator<U>& rhs) noexcept
+  {
+    return *lhs.resource() == *rhs.resource();
+  }
+};
+}  // namespace steev
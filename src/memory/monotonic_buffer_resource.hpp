@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+#include "memory/memory_resource.hpp"
+
+namespace steev
+{
+// Arena that bump-allocates from a run of ever larger chunks and never
+// reuses memory: deallocate does nothing, and everything is handed back to
+// the upstream resource at once by release() or the destructor. An optional
+// caller-provided buffer is used before any chunk is requested.
+class monotonic_buffer_resource : public memory_resource
+{
+  static constexpr std::size_t default_chunk_size = 1024;
+  static constexpr std::size_t growth_factor = 2;
+
+  // Sits at the start of every chunk taken from upstream
+  struct chunk
+  {
+    chunk* next;
+    std::size_t size;
+    std::size_t alignment;
+  };
+
+  memory_resource* upstream_;
+  void* initial_buffer_ = nullptr;
+  std::size_t initial_size_ = 0;
+  std::size_t next_chunk_size_;
+
+  unsigned char* current_ = nullptr;
+  std::size_t space_ = 0;
+  chunk* chunks_ = nullptr;
+
+  // Carves bytes with the given alignment out of the current chunk, or
+  // returns nullptr when they don't fit
+  void* bump(std::size_t bytes, std::size_t alignment) noexcept
+  {
+    auto address = reinterpret_cast<std::uintptr_t>(current_);
+    std::size_t padding = (alignment - address % alignment) % alignment;
+    if (current_ == nullptr || padding > space_ || bytes > space_ - padding) {
+      return nullptr;
+    }
+
+    unsigned char* result = current_ + padding;
+    current_ = result + bytes;
+    space_ -= padding + bytes;
+    return result;
+  }
+
+  void add_chunk(std::size_t bytes, std::size_t alignment)
+  {
+    std::size_t chunk_alignment = std::max(alignment, alignof(chunk));
+    std::size_t header =
+        (sizeof(chunk) + chunk_alignment - 1) / chunk_alignment
+        * chunk_alignment;
+    if (bytes > std::numeric_limits<std::size_t>::max() - header) {
+      throw std::bad_alloc();
+    }
+    std::size_t size = std::max(next_chunk_size_, header + bytes);
+
+    void* memory = upstream_->allocate(size, chunk_alignment);
+    chunks_ = ::new (memory) chunk {chunks_, size, chunk_alignment};
+    current_ = static_cast<unsigned char*>(memory) + header;
+    space_ = size - header;
+    next_chunk_size_ = size * growth_factor;
+  }
+
+public:
+  explicit monotonic_buffer_resource(
+      memory_resource* upstream = get_default_resource()) noexcept
+      : upstream_(upstream)
+      , next_chunk_size_(default_chunk_size)
+  {
+  }
+
+  // initial_size is the size of the first chunk requested from upstream
+  explicit monotonic_buffer_resource(
+      std::size_t initial_size,
+      memory_resource* upstream = get_default_resource()) noexcept
+      : upstream_(upstream)
+      , next_chunk_size_(std::max<std::size_t>(initial_size, 1))
+  {
+  }
+
+  monotonic_buffer_resource(
+      void* buffer,
+      std::size_t size,
+      memory_resource* upstream = get_default_resource()) noexcept
+      : upstream_(upstream)
+      , initial_buffer_(buffer)
+      , initial_size_(size)
+      , next_chunk_size_(std::max(size * growth_factor, default_chunk_size))
+      , current_(static_cast<unsigned char*>(buffer))
+      , space_(size)
+  {
+  }
+
+  monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+  monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) =
+      delete;
+
+  ~monotonic_buffer_resource() override { release(); }
+
+  // Returns every chunk to upstream and starts over from the initial buffer
+  void release() noexcept
+  {
+    while (chunks_ != nullptr) {
+      chunk* released = chunks_;
+      chunks_ = released->next;
+      upstream_->deallocate(released, released->size, released->alignment);
+    }
+    current_ = static_cast<unsigned char*>(initial_buffer_);
+    space_ = initial_size_;
+  }
+
+  memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    if (void* result = bump(bytes, alignment)) {
+      return result;
+    }
+    add_chunk(bytes, alignment);
+    if (void* result = bump(bytes, alignment)) {
+      return result;
+    }
+    throw std::bad_alloc();
+  }
+
+  void do_deallocate(void*, std::size_t, std::size_t) noexcept override {}
+
+  bool do_is_equal(const memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+}  // namespace steev
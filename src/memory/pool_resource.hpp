@@ -0,0 +1,323 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <new>
+
+#include "memory/memory_resource.hpp"
+
+namespace steev
+{
+// Tuning for the pool resources; zero picks the default
+struct pool_options
+{
+  std::size_t max_blocks_per_chunk = 0;
+  std::size_t largest_required_pool_block = 0;
+};
+
+namespace detail
+{
+// Single-threaded core shared by both pool resources. Requests are served
+// from one pool per power-of-two block size; each pool hands out blocks from
+// a free list and refills it with chunks from upstream that grow geometrically
+// up to max_blocks_per_chunk. Anything larger than the biggest block goes
+// straight to upstream.
+class pool_set
+{
+  static constexpr std::size_t smallest_block = sizeof(void*);
+  static constexpr std::size_t first_chunk_blocks = 16;
+  static constexpr std::size_t default_max_blocks = 1024;
+  static constexpr std::size_t default_largest_block = 4096;
+  static constexpr std::size_t max_pools = 32;
+
+  struct free_block
+  {
+    free_block* next;
+  };
+
+  // Trails the blocks of every chunk, so they keep their alignment
+  struct chunk
+  {
+    chunk* next;
+    std::size_t size;
+  };
+
+  // Sits just before every oversized allocation
+  struct oversized
+  {
+    oversized* prev;
+    oversized* next;
+    void* base;
+    std::size_t size;
+    std::size_t alignment;
+  };
+
+  struct size_class
+  {
+    free_block* free = nullptr;
+    chunk* chunks = nullptr;
+    std::size_t next_blocks = first_chunk_blocks;
+  };
+
+  memory_resource* upstream_;
+  pool_options options_;
+  std::size_t pool_count_;
+  size_class pools_[max_pools];
+  oversized* oversized_ = nullptr;
+
+  static std::size_t block_size(std::size_t index) noexcept
+  {
+    return smallest_block << index;
+  }
+
+  // Index of the smallest pool whose blocks fit, or pool_count_ if none does
+  std::size_t pool_index(std::size_t bytes,
+                         std::size_t alignment) const noexcept
+  {
+    std::size_t needed = std::max({bytes, alignment, smallest_block});
+    if (needed > options_.largest_required_pool_block) {
+      return pool_count_;
+    }
+    return static_cast<std::size_t>(
+        std::countr_zero(std::bit_ceil(needed) / smallest_block));
+  }
+
+  void refill(std::size_t index)
+  {
+    size_class& pool = pools_[index];
+    std::size_t size = block_size(index);
+    std::size_t blocks = pool.next_blocks;
+    std::size_t chunk_size = blocks * size + sizeof(chunk);
+
+    auto* memory =
+        static_cast<unsigned char*>(upstream_->allocate(chunk_size, size));
+    pool.chunks =
+        ::new (memory + blocks * size) chunk {pool.chunks, chunk_size};
+    for (std::size_t i = blocks; i-- > 0;) {
+      pool.free = ::new (memory + i * size) free_block {pool.free};
+    }
+    pool.next_blocks = std::min(blocks * 2, options_.max_blocks_per_chunk);
+  }
+
+  static std::size_t header_size(std::size_t alignment) noexcept
+  {
+    return (sizeof(oversized) + alignment - 1) / alignment * alignment;
+  }
+
+  void* allocate_oversized(std::size_t bytes, std::size_t alignment)
+  {
+    alignment = std::max(alignment, alignof(oversized));
+    std::size_t header = header_size(alignment);
+    if (bytes > std::numeric_limits<std::size_t>::max() - header) {
+      throw std::bad_alloc();
+    }
+    void* base = upstream_->allocate(header + bytes, alignment);
+
+    auto* result = static_cast<unsigned char*>(base) + header;
+    auto* entry = ::new (result - sizeof(oversized))
+        oversized {nullptr, oversized_, base, header + bytes, alignment};
+    if (oversized_ != nullptr) {
+      oversized_->prev = entry;
+    }
+    oversized_ = entry;
+    return result;
+  }
+
+  void deallocate_oversized(void* ptr) noexcept
+  {
+    auto* entry = reinterpret_cast<oversized*>(static_cast<unsigned char*>(ptr)
+                                               - sizeof(oversized));
+    if (entry->prev != nullptr) {
+      entry->prev->next = entry->next;
+    } else {
+      oversized_ = entry->next;
+    }
+    if (entry->next != nullptr) {
+      entry->next->prev = entry->prev;
+    }
+    upstream_->deallocate(entry->base, entry->size, entry->alignment);
+  }
+
+public:
+  pool_set(const pool_options& options, memory_resource* upstream) noexcept
+      : upstream_(upstream)
+      , options_(options)
+  {
+    if (options_.max_blocks_per_chunk == 0) {
+      options_.max_blocks_per_chunk = default_max_blocks;
+    }
+    options_.max_blocks_per_chunk =
+        std::max(options_.max_blocks_per_chunk, first_chunk_blocks);
+    if (options_.largest_required_pool_block == 0) {
+      options_.largest_required_pool_block = default_largest_block;
+    }
+    options_.largest_required_pool_block = std::bit_ceil(std::clamp(
+        options_.largest_required_pool_block,
+        smallest_block,
+        block_size(max_pools - 1)));
+    pool_count_ = static_cast<std::size_t>(std::countr_zero(
+                      options_.largest_required_pool_block / smallest_block))
+        + 1;
+  }
+
+  pool_set(const pool_set&) = delete;
+  pool_set& operator=(const pool_set&) = delete;
+
+  ~pool_set() { release(); }
+
+  void* allocate(std::size_t bytes, std::size_t alignment)
+  {
+    std::size_t index = pool_index(bytes, alignment);
+    if (index == pool_count_) {
+      return allocate_oversized(bytes, alignment);
+    }
+
+    size_class& pool = pools_[index];
+    if (pool.free == nullptr) {
+      refill(index);
+    }
+    free_block* block = pool.free;
+    pool.free = block->next;
+    return block;
+  }
+
+  void deallocate(void* ptr, std::size_t bytes, std::size_t alignment) noexcept
+  {
+    std::size_t index = pool_index(bytes, alignment);
+    if (index == pool_count_) {
+      deallocate_oversized(ptr);
+      return;
+    }
+
+    size_class& pool = pools_[index];
+    pool.free = ::new (ptr) free_block {pool.free};
+  }
+
+  void release() noexcept
+  {
+    for (std::size_t index = 0; index < pool_count_; index++) {
+      size_class& pool = pools_[index];
+      std::size_t size = block_size(index);
+      while (pool.chunks != nullptr) {
+        chunk* released = pool.chunks;
+        pool.chunks = released->next;
+        auto* base = reinterpret_cast<unsigned char*>(released)
+            - (released->size - sizeof(chunk));
+        upstream_->deallocate(base, released->size, size);
+      }
+      pool = {};
+    }
+    while (oversized_ != nullptr) {
+      deallocate_oversized(oversized_ + 1);
+    }
+  }
+
+  memory_resource* upstream() const noexcept { return upstream_; }
+  const pool_options& options() const noexcept { return options_; }
+};
+}  // namespace detail
+
+// Pools of fixed-size blocks with no locking; for use from a single thread.
+// Freed blocks are reused, and release() or the destructor hands everything
+// back to upstream.
+class unsynchronized_pool_resource : public memory_resource
+{
+  detail::pool_set pools_;
+
+public:
+  explicit unsynchronized_pool_resource(
+      const pool_options& options = {},
+      memory_resource* upstream = get_default_resource()) noexcept
+      : pools_(options, upstream)
+  {
+  }
+
+  explicit unsynchronized_pool_resource(memory_resource* upstream) noexcept
+      : unsynchronized_pool_resource({}, upstream)
+  {
+  }
+
+  void release() noexcept { pools_.release(); }
+
+  memory_resource* upstream_resource() const noexcept
+  {
+    return pools_.upstream();
+  }
+
+  pool_options options() const noexcept { return pools_.options(); }
+
+protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    return pools_.allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* ptr,
+                     std::size_t bytes,
+                     std::size_t alignment) noexcept override
+  {
+    pools_.deallocate(ptr, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+
+// The same pools behind a mutex, safe to share between threads
+class synchronized_pool_resource : public memory_resource
+{
+  std::mutex mutex_;
+  detail::pool_set pools_;
+
+public:
+  explicit synchronized_pool_resource(
+      const pool_options& options = {},
+      memory_resource* upstream = get_default_resource()) noexcept
+      : pools_(options, upstream)
+  {
+  }
+
+  explicit synchronized_pool_resource(memory_resource* upstream) noexcept
+      : synchronized_pool_resource({}, upstream)
+  {
+  }
+
+  void release() noexcept
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pools_.release();
+  }
+
+  memory_resource* upstream_resource() const noexcept
+  {
+    return pools_.upstream();
+  }
+
+  pool_options options() const noexcept { return pools_.options(); }
+
+protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pools_.allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* ptr,
+                     std::size_t bytes,
+                     std::size_t alignment) noexcept override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pools_.deallocate(ptr, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+}  // namespace steev
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace steev
+{
+// A type is trivially relocatable when moving an object to a new address and
+// destroying the original is equivalent to copying its bytes. Types holding
+// no self-referential pointers (smart pointers, most handles) qualify even
+// though they aren't trivially copyable; specialize this trait to opt in.
+template<typename T>
+struct is_trivially_relocatable
+    : std::bool_constant<std::is_trivially_move_constructible_v<T>
+                         && std::is_trivially_destructible_v<T>>
+{
+};
+
+template<typename T>
+struct is_trivially_relocatable<const T> : is_trivially_relocatable<T>
+{
+};
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+// Relocates [first, last) into the uninitialized storage at dest, leaving the
+// source range uninitialized. The ranges must not overlap.
+template<typename T>
+T* uninitialized_relocate(T* first, T* last, T* dest)
+{
+  if constexpr (is_trivially_relocatable_v<T>) {
+    auto count = static_cast<std::size_t>(last - first);
+    if (count != 0) {
+      std::memcpy(static_cast<void*>(dest),
+                  static_cast<const void*>(first),
+                  count * sizeof(T));
+    }
+    return dest + count;
+  } else {
+    T* out = dest;
+    try {
+      for (T* it = first; it != last; ++it, ++out) {
+        std::construct_at(out, std::move_if_noexcept(*it));
+      }
+    } catch (...) {
+      std::destroy(dest, out);
+      throw;
+    }
+    std::destroy(first, last);
+    return out;
+  }
+}
+}  // namespace steev
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+#include "control_block.hpp"
+#include "shared_ptr.hpp"
+#include "thread_policy.hpp"
+
+namespace steev
+{
+// Lock-free atomic shared_ptr built on split reference counting.
+//
+// The atomic keeps a single 64-bit word: the control block address in the
+// low 48 bits and a local count in the high 16. Whenever a block is stored,
+// the atomic takes `reserve` extra strong references on it up front. A load
+// claims one of them by bumping the local count with a CAS on the word, so
+// readers never touch the control block itself. Once half the reserve is
+// claimed, a reader tops it up again. Whoever swaps a block out gives back
+// the references nobody claimed.
+//
+// Every operation is sequentially consistent. The atomic's prepaid
+// references show up in use_count() of the objects it holds.
+//
+// Addresses must fit in 48 bits. That holds for user space on x86-64 and
+// AArch64, unless a process opts into larger addresses with 5-level paging.
+// ABA can't bite: a reader that still uses the word's old value holds a
+// reference to that block, so it can't be freed and reused for a new one.
+template<typename T>
+class atomic<shared_ptr<T>>
+{
+  using control_block = steev::control_block<thread_safe_counter>;
+
+  static_assert(sizeof(void*) == sizeof(uint64_t),
+                "The block address and count share a 64-bit word");
+
+  static constexpr int count_shift = 48;
+  static constexpr uint64_t local_one = uint64_t {1} << count_shift;
+  static constexpr uint64_t block_mask = local_one - 1;
+  static constexpr uint32_t reserve = 1 << 12;
+
+  mutable std::atomic<uint64_t> word_;
+
+  static control_block* block_of(uint64_t word) noexcept
+  {
+    return reinterpret_cast<control_block*>(word & block_mask);
+  }
+
+  static uint32_t local_of(uint64_t word) noexcept
+  {
+    return static_cast<uint32_t>(word >> count_shift);
+  }
+
+  // Moves the reference held by desired into a word, prepaying for readers
+  static uint64_t to_word(shared_ptr<T>&& desired) noexcept
+  {
+    control_block* block = std::exchange(desired.ctrl, nullptr);
+    desired.pointer = nullptr;
+    if (block == nullptr) {
+      return 0;
+    }
+
+    auto address = reinterpret_cast<uint64_t>(block);
+    assert((address & ~block_mask) == 0);
+    block->add_refs(reserve);
+    return address;
+  }
+
+  // Turns a word taken out of the atomic back into a single reference,
+  // returning the prepaid ones nobody claimed
+  static shared_ptr<T> from_word(uint64_t word) noexcept
+  {
+    control_block* block = block_of(word);
+    if (block == nullptr) {
+      return shared_ptr<T>();
+    }
+
+    block->remove_refs(reserve - local_of(word));
+    return shared_ptr<T>(static_cast<T*>(block->object()), block);
+  }
+
+  shared_ptr<T> claim() const noexcept
+  {
+    uint64_t current = word_.load();
+    while (true) {
+      if (block_of(current) == nullptr) {
+        return shared_ptr<T>();
+      }
+      // Every prepaid reference is taken: wait for a reader to top them up
+      if (local_of(current) == reserve) {
+        current = word_.load();
+        continue;
+      }
+      if (word_.compare_exchange_weak(current, current + local_one)) {
+        break;
+      }
+    }
+
+    control_block* block = block_of(current);
+    refill(block, current + local_one);
+    return shared_ptr<T>(static_cast<T*>(block->object()), block);
+  }
+
+  // Called with a claimed reference on block; adds more to the reserve once
+  // the claims reach half of it, unless another reader or a store got there
+  // first
+  void refill(control_block* block, uint64_t current) const noexcept
+  {
+    constexpr uint32_t batch = reserve / 2;
+    if (local_of(current) < batch) {
+      return;
+    }
+
+    block->add_refs(batch);
+    while (block_of(current) == block && local_of(current) >= batch) {
+      if (word_.compare_exchange_weak(current, current - batch * local_one)) {
+        return;
+      }
+    }
+    block->remove_refs(batch);
+  }
+
+public:
+  static constexpr bool is_always_lock_free =
+      std::atomic<uint64_t>::is_always_lock_free;
+
+  atomic() noexcept
+      : word_(0)
+  {
+  }
+
+  atomic(shared_ptr<T> desired) noexcept
+      : word_(to_word(std::move(desired)))
+  {
+  }
+
+  atomic(const atomic&) = delete;
+  atomic& operator=(const atomic&) = delete;
+
+  ~atomic() { from_word(word_.load(std::memory_order_relaxed)); }
+
+  bool is_lock_free() const noexcept { return word_.is_lock_free(); }
+
+  shared_ptr<T> load() const noexcept { return claim(); }
+
+  operator shared_ptr<T>() const noexcept { return load(); }
+
+  void store(shared_ptr<T> desired) noexcept
+  {
+    exchange(std::move(desired));
+  }
+
+  atomic& operator=(shared_ptr<T> desired) noexcept
+  {
+    store(std::move(desired));
+    return *this;
+  }
+
+  shared_ptr<T> exchange(shared_ptr<T> desired) noexcept
+  {
+    return from_word(word_.exchange(to_word(std::move(desired))));
+  }
+
+  // Succeeds when the atomic holds the same control block as expected;
+  // otherwise loads the current value into expected
+  bool compare_exchange_strong(shared_ptr<T>& expected,
+                               shared_ptr<T> desired) noexcept
+  {
+    uint64_t replacement = to_word(std::move(desired));
+    uint64_t current = word_.load();
+    while (true) {
+      if (block_of(current) == expected.ctrl) {
+        if (word_.compare_exchange_weak(current, replacement)) {
+          from_word(current);
+          return true;
+        }
+        continue;
+      }
+
+      shared_ptr<T> actual = claim();
+      if (actual.ctrl != expected.ctrl) {
+        expected = std::move(actual);
+        from_word(replacement);
+        return false;
+      }
+      current = word_.load();
+    }
+  }
+
+  bool compare_exchange_weak(shared_ptr<T>& expected,
+                             shared_ptr<T> desired) noexcept
+  {
+    return compare_exchange_strong(expected, std::move(desired));
+  }
+};
+
+// Shorthand for the only atomic specialisation there is
+template<typename T>
+using atomic_shared_ptr = atomic<shared_ptr<T>>;
+}  // namespace steev
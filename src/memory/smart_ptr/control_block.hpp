@@ -1,38 +1,260 @@
 #pragma once
 
-#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "control_block_pool.hpp"
+#include "thread_policy.hpp"
+#include "memory/allocator_traits.hpp"
+#include "memory/instrumentation.hpp"
 
 namespace steev
 {
 
+// Both counts share one 64-bit word: strong in the low half, weak in the
+// high half. The weak count carries an extra reference on behalf of all
+// strong owners, dropped once the object is disposed, so whoever takes the
+// weak count to zero frees the block; each decision is a single RMW.
+template<typename ThreadPolicy>
 class control_block
 {
-  std::atomic<uint32_t> strong_count {1};
-  std::atomic<uint32_t> weak_count {0};
+  using count_type = typename ThreadPolicy::template counter<uint64_t>;
+
+  static constexpr uint64_t strong_one = 1;
+  static constexpr uint64_t weak_one = uint64_t {1} << 32;
+  static constexpr uint64_t strong_mask = weak_one - 1;
+
+  count_type counts {strong_one | weak_one};
+
+  static uint32_t strong_part(uint64_t word) noexcept
+  {
+    return static_cast<uint32_t>(word & strong_mask);
+  }
+
+  static uint32_t weak_part(uint64_t word) noexcept
+  {
+    return static_cast<uint32_t>(word >> 32);
+  }
+
+protected:
+  ~control_block() = default;
+
+  // Destroys the managed object once the last strong reference is dropped
+  virtual void dispose() noexcept = 0;
+
+  // Frees the block itself once no strong or weak references remain
+  virtual void destroy() noexcept = 0;
 
 public:
-  uint32_t get_refs() const noexcept { return strong_count; }
-  uint32_t get_weak_refs() const noexcept { return strong_count; }
+  control_block() = default;
+  control_block(const control_block&) = delete;
+  control_block& operator=(const control_block&) = delete;
+
+  // Address of the managed object, for owners that only keep the block
+  virtual void* object() noexcept = 0;
+
+  uint32_t get_refs() const noexcept
+  {
+    return strong_part(ThreadPolicy::load(counts, std::memory_order_relaxed));
+  }
+
+  uint32_t get_weak_refs() const noexcept
+  {
+    uint64_t word = ThreadPolicy::load(counts, std::memory_order_relaxed);
+    return weak_part(word) - (strong_part(word) != 0 ? 1 : 0);
+  }
+
+  // Taking a new reference only needs the count to stay consistent; the
+  // caller already holds one, which keeps the block alive
+  void add_ref() noexcept
+  {
+    ThreadPolicy::fetch_add(counts, strong_one, std::memory_order_relaxed);
+  }
 
-  void add_ref() noexcept { strong_count++; }
+  // Takes a strong reference unless the object is already gone
+  bool try_add_ref() noexcept
+  {
+    uint64_t word = ThreadPolicy::load(counts, std::memory_order_relaxed);
+    while (strong_part(word) != 0) {
+      if (ThreadPolicy::compare_exchange_weak(
+              counts, word, word + strong_one, std::memory_order_relaxed))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
 
   uint32_t remove_ref() noexcept
   {
-    uint32_t new_strong_count = --strong_count;
+    // Sole owner and no weak references: nobody else can observe the block
+    if (ThreadPolicy::load(counts, std::memory_order_acquire)
+        == (strong_one | weak_one))
+    {
+      dispose();
+      destroy();
+      return 0;
+    }
 
-    if (new_strong_count == 0 && weak_count == 0) {
-      delete this;
+    uint64_t old =
+        ThreadPolicy::fetch_sub(counts, strong_one, std::memory_order_acq_rel);
+    if (strong_part(old) != 1) {
+      return strong_part(old) - 1;
     }
-    return new_strong_count;
+
+    dispose();
+    remove_weak_ref();
+    return 0;
+  }
+
+  // Bulk counterparts for owners that hold references on behalf of others.
+  // remove_refs must leave at least one behind, so it never disposes.
+  void add_refs(uint32_t count) noexcept
+  {
+    ThreadPolicy::fetch_add(
+        counts, count * strong_one, std::memory_order_relaxed);
   }
 
-  void add_weak_ref() noexcept { weak_count++; }
+  void remove_refs(uint32_t count) noexcept
+  {
+    [[maybe_unused]] uint64_t old = ThreadPolicy::fetch_sub(
+        counts, count * strong_one, std::memory_order_release);
+    assert(strong_part(old) > count);
+  }
+
+  void add_weak_ref() noexcept
+  {
+    ThreadPolicy::fetch_add(counts, weak_one, std::memory_order_relaxed);
+  }
 
   void remove_weak_ref() noexcept
   {
-    if (--weak_count == 0 && strong_count == 0) {
-      delete this;
+    uint64_t old =
+        ThreadPolicy::fetch_sub(counts, weak_one, std::memory_order_acq_rel);
+    if (weak_part(old) == 1) {
+      destroy();
+    }
+  }
+};
+
+// Block for an object allocated separately, released through its deleter
+template<typename T, typename Deleter, typename ThreadPolicy>
+class pointer_control_block final : public control_block<ThreadPolicy>
+{
+  T* pointer_;
+  [[no_unique_address]] Deleter deleter_;
+
+  void dispose() noexcept override { deleter_(pointer_); }
+
+  void destroy() noexcept override { delete this; }
+
+  void* object() noexcept override
+  {
+    return const_cast<std::remove_cv_t<T>*>(pointer_);
+  }
+
+  static constexpr bool pooled() noexcept
+  {
+    return sizeof(pointer_control_block) <= control_block_pool::slot_size
+        && alignof(pointer_control_block) <= control_block_pool::slot_alignment;
+  }
+
+public:
+  pointer_control_block(T* pointer, Deleter deleter)
+      : pointer_(pointer)
+      , deleter_(std::move(deleter))
+  {
+  }
+
+  static void* operator new(std::size_t size)
+  {
+    void* ptr = nullptr;
+    if constexpr (pooled()) {
+      ptr = control_block_pool::allocate();
+    } else {
+      ptr = ::operator new(size);
+    }
+    // Only counted once it has succeeded, so a throw leaves nothing to undo
+    instrumentation::on_allocate<pointer_control_block>(size);
+    return ptr;
+  }
+
+  static void operator delete(void* ptr) noexcept
+  {
+    instrumentation::on_deallocate<pointer_control_block>();
+    if constexpr (pooled()) {
+      control_block_pool::deallocate(ptr);
+    } else {
+      ::operator delete(ptr);
+    }
+  }
+};
+
+// Block with the object stored right after the counts, so both come from a
+// single allocation. Once the object is destroyed the memory stays around
+// until the last weak reference lets go of the block.
+template<typename T, typename Allocator, typename ThreadPolicy>
+class inplace_control_block final : public control_block<ThreadPolicy>
+{
+  using object_allocator =
+      typename allocator_traits<Allocator>::template rebind_alloc<
+          std::remove_cv_t<T>>;
+  using block_allocator = typename allocator_traits<
+      Allocator>::template rebind_alloc<inplace_control_block>;
+
+  [[no_unique_address]] object_allocator alloc_;
+  union
+  {
+    std::remove_cv_t<T> object_;
+  };
+
+  template<typename... Args>
+  explicit inplace_control_block(const Allocator& alloc, Args&&... args)
+      : alloc_(alloc)
+  {
+    allocator_traits<object_allocator>::construct(
+        alloc_, &object_, std::forward<Args>(args)...);
+  }
+
+  ~inplace_control_block() {}
+
+  void dispose() noexcept override
+  {
+    allocator_traits<object_allocator>::destroy(alloc_, &object_);
+  }
+
+  void destroy() noexcept override
+  {
+    block_allocator alloc(alloc_);
+    this->~inplace_control_block();
+    allocator_traits<block_allocator>::deallocate(alloc, this, 1);
+    instrumentation::on_deallocate<inplace_control_block>();
+  }
+
+  void* object() noexcept override { return &object_; }
+
+public:
+  template<typename... Args>
+  static inplace_control_block* create(const Allocator& alloc, Args&&... args)
+  {
+    block_allocator block_alloc(alloc);
+    inplace_control_block* block =
+        allocator_traits<block_allocator>::allocate(block_alloc, 1);
+    try {
+      ::new (static_cast<void*>(block))
+          inplace_control_block(alloc, std::forward<Args>(args)...);
+    } catch (...) {
+      allocator_traits<block_allocator>::deallocate(block_alloc, block, 1);
+      throw;
     }
+    instrumentation::on_allocate<inplace_control_block>(
+        sizeof(inplace_control_block));
+    return block;
   }
+
+  T* get() noexcept { return &object_; }
 };
 }  // namespace steev
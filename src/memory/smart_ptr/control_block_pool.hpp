@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+namespace steev
+{
+// Fixed-size slab allocator for control blocks. Each thread keeps a free list
+// of slots; it refills from, and hands surplus back to, a shared depot in
+// batches so the depot's lock is taken once per batch_size blocks at most.
+// Slabs are never returned to the system.
+class control_block_pool
+{
+public:
+  static constexpr std::size_t slot_size = 32;
+  static constexpr std::size_t slot_alignment = 16;
+  static constexpr std::size_t batch_size = 64;
+  static constexpr std::size_t slab_slots = 16 * batch_size;
+
+  static void* allocate()
+  {
+    thread_cache& cache = local_cache();
+    if (cache.exited) {
+      slot* single = depot().take_batch();
+      if (single->next != nullptr) {
+        single->next->batch_count = single->batch_count - 1;
+        depot().give_batch(single->next);
+      }
+      return single;
+    }
+
+    if (cache.head == nullptr) {
+      cache.head = depot().take_batch();
+      cache.count = cache.head->batch_count;
+    }
+    slot* taken = cache.head;
+    cache.head = taken->next;
+    --cache.count;
+    return taken;
+  }
+
+  static void deallocate(void* ptr) noexcept
+  {
+    thread_cache& cache = local_cache();
+    if (cache.exited) {
+      depot().give_batch(::new (ptr) slot {nullptr, nullptr, 1});
+      return;
+    }
+
+    cache.head = ::new (ptr) slot {cache.head, nullptr, 0};
+    if (++cache.count >= 2 * batch_size) {
+      cache.flush(batch_size);
+    }
+  }
+
+private:
+  struct slot
+  {
+    slot* next;
+    // Only meaningful on the first slot of a batch parked in the depot
+    slot* next_batch;
+    std::size_t batch_count;
+  };
+
+  static_assert(sizeof(slot) <= slot_size);
+
+  class shared_depot
+  {
+    std::mutex mutex_;
+    slot* batches_ = nullptr;
+
+    // Threads the slots of a fresh slab into batches and parks them
+    void carve_slab()
+    {
+      auto* slab = static_cast<unsigned char*>(::operator new(
+          slot_size * slab_slots, std::align_val_t {slot_alignment}));
+
+      for (std::size_t first = 0; first < slab_slots; first += batch_size) {
+        slot* head = nullptr;
+        for (std::size_t i = first + batch_size; i-- > first;) {
+          head = ::new (slab + i * slot_size) slot {head, nullptr, 0};
+        }
+        head->batch_count = batch_size;
+        head->next_batch = batches_;
+        batches_ = head;
+      }
+    }
+
+  public:
+    slot* take_batch()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (batches_ == nullptr) {
+        carve_slab();
+      }
+      slot* batch = batches_;
+      batches_ = batch->next_batch;
+      return batch;
+    }
+
+    void give_batch(slot* batch) noexcept
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      batch->next_batch = batches_;
+      batches_ = batch;
+    }
+  };
+
+  // Trivially destructible so it stays usable while other thread_locals are
+  // torn down; the exit hook below flushes it and flips `exited`
+  struct thread_cache
+  {
+    slot* head;
+    std::size_t count;
+    bool exited;
+
+    void flush(std::size_t slots) noexcept
+    {
+      slot* batch = head;
+      slot* last = head;
+      for (std::size_t i = 1; i < slots; i++) {
+        last = last->next;
+      }
+      head = last->next;
+      last->next = nullptr;
+      count -= slots;
+
+      batch->batch_count = slots;
+      depot().give_batch(batch);
+    }
+  };
+
+  struct thread_exit_hook
+  {
+    thread_exit_hook() = default;
+    thread_exit_hook(const thread_exit_hook&) = delete;
+    thread_exit_hook& operator=(const thread_exit_hook&) = delete;
+
+    ~thread_exit_hook()
+    {
+      thread_cache& cache = cache_storage();
+      if (cache.count != 0) {
+        cache.flush(cache.count);
+      }
+      cache.exited = true;
+    }
+  };
+
+  static shared_depot& depot()
+  {
+    // Leaked on purpose: blocks may still be freed during static destruction
+    static auto* instance = new shared_depot;
+    return *instance;
+  }
+
+  static thread_cache& cache_storage() noexcept
+  {
+    thread_local thread_cache cache {nullptr, 0, false};
+    return cache;
+  }
+
+  static thread_cache& local_cache() noexcept
+  {
+    thread_cache& cache = cache_storage();
+    if (!cache.exited) {
+      thread_local thread_exit_hook hook;
+      static_cast<void>(hook);
+    }
+    return cache;
+  }
+};
+}  // namespace steev
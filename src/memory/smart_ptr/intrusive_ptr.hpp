@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+#include "memory/relocate.hpp"
+#include "thread_policy.hpp"
+
+namespace steev
+{
+// CRTP base that embeds the reference count in Derived itself. Counts follow
+// control_block: new references are relaxed, dropping one is acq_rel, and
+// whoever drops the last deletes the object. Copying an object gives the
+// copy a fresh count.
+template<typename Derived, typename ThreadPolicy = thread_safe_counter>
+class intrusive_ref_counter
+{
+  mutable typename ThreadPolicy::template counter<uint32_t> refs_ {0};
+
+protected:
+  intrusive_ref_counter() noexcept = default;
+
+  intrusive_ref_counter(const intrusive_ref_counter&) noexcept
+      : intrusive_ref_counter()
+  {
+  }
+
+  intrusive_ref_counter& operator=(const intrusive_ref_counter&) noexcept
+  {
+    return *this;
+  }
+
+  ~intrusive_ref_counter() = default;
+
+private:
+  // Out of line so that GCC 12 can't follow the delete into a caller's
+  // later use_count() on a surviving object and warn of a use after free
+  [[gnu::noinline]] static void destroy(const intrusive_ref_counter* counter)
+  {
+    delete static_cast<const Derived*>(counter);
+  }
+
+public:
+  uint32_t use_count() const noexcept
+  {
+    return ThreadPolicy::load(refs_, std::memory_order_relaxed);
+  }
+
+  // Found through ADL by intrusive_ptr
+  friend void intrusive_ptr_add_ref(const intrusive_ref_counter* counter)
+  {
+    ThreadPolicy::fetch_add(
+        counter->refs_, uint32_t {1}, std::memory_order_relaxed);
+  }
+
+  friend void intrusive_ptr_release(const intrusive_ref_counter* counter)
+  {
+    if (ThreadPolicy::fetch_sub(
+            counter->refs_, uint32_t {1}, std::memory_order_acq_rel)
+        == 1)
+    {
+      destroy(counter);
+    }
+  }
+};
+
+// Pointer-sized owner of an object that counts its own references. T must
+// have intrusive_ptr_add_ref(T*) and intrusive_ptr_release(T*) reachable
+// through ADL; deriving from intrusive_ref_counter provides both.
+template<typename T>
+class intrusive_ptr
+{
+  T* pointer_;
+
+public:
+  intrusive_ptr() noexcept
+      : pointer_(nullptr)
+  {
+  }
+
+  // With add_ref false, adopts a reference the caller already counted
+  intrusive_ptr(T* ptr, bool add_ref = true)
+      : pointer_(ptr)
+  {
+    if (pointer_ != nullptr && add_ref) {
+      intrusive_ptr_add_ref(pointer_);
+    }
+  }
+
+  intrusive_ptr(const intrusive_ptr& other)
+      : intrusive_ptr(other.pointer_)
+  {
+  }
+
+  intrusive_ptr(intrusive_ptr&& other) noexcept
+      : pointer_(std::exchange(other.pointer_, nullptr))
+  {
+  }
+
+  ~intrusive_ptr()
+  {
+    if (pointer_ != nullptr) {
+      intrusive_ptr_release(pointer_);
+    }
+  }
+
+  intrusive_ptr& operator=(const intrusive_ptr& other)
+  {
+    intrusive_ptr(other).swap(*this);
+    return *this;
+  }
+
+  intrusive_ptr& operator=(intrusive_ptr&& other) noexcept
+  {
+    intrusive_ptr(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  intrusive_ptr& operator=(T* ptr)
+  {
+    intrusive_ptr(ptr).swap(*this);
+    return *this;
+  }
+
+  void reset() noexcept { intrusive_ptr().swap(*this); }
+
+  void reset(T* ptr, bool add_ref = true)
+  {
+    intrusive_ptr(ptr, add_ref).swap(*this);
+  }
+
+  // Gives up ownership without dropping the reference
+  T* detach() noexcept { return std::exchange(pointer_, nullptr); }
+
+  void swap(intrusive_ptr& other) noexcept
+  {
+    std::swap(pointer_, other.pointer_);
+  }
+
+  T* get() const noexcept { return pointer_; }
+  T& operator*() const noexcept { return *pointer_; }
+  T* operator->() const noexcept { return pointer_; }
+
+  explicit operator bool() const noexcept { return pointer_ != nullptr; }
+
+  bool operator==(const intrusive_ptr& other) const noexcept
+  {
+    return pointer_ == other.pointer_;
+  }
+
+  bool operator==(const T* ptr) const noexcept { return pointer_ == ptr; }
+};
+
+// The count lives in the object, so moving the handle's bytes is enough
+template<typename T>
+struct is_trivially_relocatable<intrusive_ptr<T>> : std::true_type
+{
+};
+
+template<typename T, typename... Args>
+intrusive_ptr<T> make_intrusive(Args&&... args)
+{
+  return intrusive_ptr<T>(new T(std::forward<Args>(args)...));
+}
+}  // namespace steev
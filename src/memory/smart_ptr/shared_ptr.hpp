@@ -1,27 +1,66 @@
 #pragma once
 
 #include <cassert>
+#include <concepts>
+#include <utility>
 
 #include "control_block.hpp"
+#include "memory/allocator.hpp"
 #include "memory/default_delete.hpp"
+#include "memory/relocate.hpp"
+#include "thread_policy.hpp"
 
 namespace steev
 {
 
-template<typename T>
+template<typename T, typename ThreadPolicy>
 class weak_ptr;
 
-template<typename T, typename Deleter = default_delete<T>>
+template<typename T, typename ThreadPolicy>
+class shared_ptr;
+
+template<typename T>
+class atomic;
+
+namespace detail
+{
+template<typename T,
+         typename ThreadPolicy,
+         typename Allocator,
+         typename... Args>
+shared_ptr<T, ThreadPolicy> allocate_shared(const Allocator& alloc,
+                                            Args&&... args);
+}  // namespace detail
+
+// ThreadPolicy picks how the reference counts are updated; see
+// thread_policy.hpp and local_shared_ptr below
+template<typename T, typename ThreadPolicy = thread_safe_counter>
 class shared_ptr
 {
+  using control_block = steev::control_block<ThreadPolicy>;
+
   T* pointer;
   control_block* ctrl;
-  [[no_unique_address]] Deleter deleter {};
+
+  // Adopts a reference already counted in ctrl
+  shared_ptr(T* ptr, control_block* block) noexcept
+      : pointer(ptr)
+      , ctrl(block)
+  {
+  }
 
 public:
   explicit shared_ptr(T* ptr)
       : pointer(ptr)
-      , ctrl(make_control_block(ptr))
+      , ctrl(make_control_block(ptr, default_delete<T> {}))
+  {
+  }
+
+  template<typename Deleter>
+    requires std::invocable<Deleter&, T*>
+  shared_ptr(T* ptr, Deleter deleter)
+      : pointer(ptr)
+      , ctrl(make_control_block(ptr, std::move(deleter)))
   {
   }
 
@@ -88,8 +127,18 @@ public:
   {
     release();
 
+    ctrl = make_control_block(ptr, default_delete<T> {});
+    pointer = ptr;
+  }
+
+  template<typename Deleter>
+    requires std::invocable<Deleter&, T*>
+  void reset(T* ptr, Deleter deleter)
+  {
+    release();
+
+    ctrl = make_control_block(ptr, std::move(deleter));
     pointer = ptr;
-    ctrl = make_control_block(pointer);
   }
 
   T& operator*() const noexcept { return *pointer; }
@@ -111,13 +160,21 @@ public:
   ~shared_ptr() noexcept { release(); }
 
 private:
-  static control_block* make_control_block(T* pointer)
+  template<typename Deleter>
+  static control_block* make_control_block(T* pointer, Deleter deleter)
   {
     if (pointer == nullptr) {
       return nullptr;
     }
-    return new control_block {};
+    try {
+      return new pointer_control_block<T, Deleter, ThreadPolicy>(pointer,
+                                                                 deleter);
+    } catch (...) {
+      deleter(pointer);
+      throw;
+    }
   }
+
   void release() noexcept
   {
     assert(!pointer == !ctrl);
@@ -126,27 +183,73 @@ private:
       return;
     }
 
-    if (ctrl->remove_ref() == 0) {
-      deleter(pointer);
-    }
+    ctrl->remove_ref();
 
     pointer = nullptr;
     ctrl = nullptr;
   }
 
-  friend class weak_ptr<T>;
+  friend class weak_ptr<T, ThreadPolicy>;
+  friend class atomic<shared_ptr>;
+
+  template<typename U, typename Policy, typename Allocator, typename... Args>
+  friend shared_ptr<U, Policy> detail::allocate_shared(const Allocator& alloc,
+                                                       Args&&... args);
 };
 
+// shared_ptr for objects that never leave the thread that owns them
+template<typename T>
+using local_shared_ptr = shared_ptr<T, thread_unsafe_counter>;
+
+// The control block tracks counts, not addresses of the owners
+template<typename T, typename ThreadPolicy>
+struct is_trivially_relocatable<shared_ptr<T, ThreadPolicy>> : std::true_type
+{
+};
+
+namespace detail
+{
+template<typename T,
+         typename ThreadPolicy,
+         typename Allocator,
+         typename... Args>
+shared_ptr<T, ThreadPolicy> allocate_shared(const Allocator& alloc,
+                                            Args&&... args)
+{
+  auto* block = inplace_control_block<T, Allocator, ThreadPolicy>::create(
+      alloc, std::forward<Args>(args)...);
+  return shared_ptr<T, ThreadPolicy>(block->get(), block);
+}
+}  // namespace detail
+
+// Creates the object and its control block in one allocation from alloc
+template<typename T, typename Allocator, typename... Args>
+shared_ptr<T> allocate_shared(const Allocator& alloc, Args&&... args)
+{
+  return detail::allocate_shared<T, thread_safe_counter>(
+      alloc, std::forward<Args>(args)...);
+}
+
 template<typename T, typename... Args>
-shared_ptr<T> make_shared(Args... args)
+shared_ptr<T> make_shared(Args&&... args)
 {
-  return shared_ptr<T>(new T(std::forward<Args...>(args...)));
+  return allocate_shared<T>(steev::allocator<T> {},
+                            std::forward<Args>(args)...);
 }
 
-template<typename T>
-shared_ptr<T> make_shared()
+template<typename T, typename Allocator, typename... Args>
+local_shared_ptr<T> allocate_local_shared(const Allocator& alloc,
+                                          Args&&... args)
+{
+  return detail::allocate_shared<T, thread_unsafe_counter>(
+      alloc, std::forward<Args>(args)...);
+}
+
+template<typename T, typename... Args>
+local_shared_ptr<T> make_local_shared(Args&&... args)
 {
-  return shared_ptr<T>(new T {});
+  return allocate_local_shared<T>(steev::allocator<T> {},
+                                  std::forward<Args>(args)...);
 }
 
 }  // namespace steev
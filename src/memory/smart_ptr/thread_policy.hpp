@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+
+namespace steev
+{
+// Reference counts shared between threads: every update is an atomic RMW
+struct thread_safe_counter
+{
+  template<typename U>
+  using counter = std::atomic<U>;
+
+  template<typename U>
+  static U load(const counter<U>& count, std::memory_order order) noexcept
+  {
+    return count.load(order);
+  }
+
+  template<typename U>
+  static U fetch_add(counter<U>& count,
+                     U value,
+                     std::memory_order order) noexcept
+  {
+    return count.fetch_add(value, order);
+  }
+
+  template<typename U>
+  static U fetch_sub(counter<U>& count,
+                     U value,
+                     std::memory_order order) noexcept
+  {
+    return count.fetch_sub(value, order);
+  }
+
+  template<typename U>
+  static bool compare_exchange_weak(counter<U>& count,
+                                    U& expected,
+                                    U desired,
+                                    std::memory_order order) noexcept
+  {
+    return count.compare_exchange_weak(
+        expected, desired, order, std::memory_order_relaxed);
+  }
+};
+
+// Reference counts confined to one thread: plain loads and stores, so no
+// lock-prefixed instructions. Owners must never be shared across threads.
+struct thread_unsafe_counter
+{
+  template<typename U>
+  using counter = U;
+
+  template<typename U>
+  static U load(const counter<U>& count, std::memory_order) noexcept
+  {
+    return count;
+  }
+
+  template<typename U>
+  static U fetch_add(counter<U>& count, U value, std::memory_order) noexcept
+  {
+    U old = count;
+    count = static_cast<U>(old + value);
+    return old;
+  }
+
+  template<typename U>
+  static U fetch_sub(counter<U>& count, U value, std::memory_order) noexcept
+  {
+    U old = count;
+    count = static_cast<U>(old - value);
+    return old;
+  }
+
+  template<typename U>
+  static bool compare_exchange_weak(counter<U>& count,
+                                    U& expected,
+                                    U desired,
+                                    std::memory_order) noexcept
+  {
+    if (count != expected) {
+      expected = count;
+      return false;
+    }
+    count = desired;
+    return true;
+  }
+};
+}  // namespace steev
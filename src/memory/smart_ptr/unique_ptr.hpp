@@ -1,6 +1,13 @@
 #pragma once
 
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "memory/allocator_traits.hpp"
 #include "memory/default_delete.hpp"
+#include "memory/instrumentation.hpp"
+#include "memory/relocate.hpp"
 
 namespace steev
 {
@@ -85,7 +92,7 @@ template<typename T, typename Deleter>
 class unique_ptr<T[], Deleter>
 {
   T* pointer_;
-  Deleter deleter_ {};
+  [[no_unique_address]] Deleter deleter_ {};
 
 public:
   explicit unique_ptr(T* ptr)
@@ -93,7 +100,15 @@ public:
   {
   }
 
+  // For deleters that carry state, like allocator_delete
+  unique_ptr(T* ptr, const Deleter& deleter)
+      : pointer_(ptr)
+      , deleter_(deleter)
+  {
+  }
+
   Deleter& get_deleter() { return deleter_; }
+  const Deleter& get_deleter() const { return deleter_; }
 
   unique_ptr()
       : pointer_ {nullptr}
@@ -102,8 +117,10 @@ public:
 
   unique_ptr& operator=(unique_ptr&& ptr) noexcept
   {
-    pointer_ = ptr.pointer_;
-    ptr.pointer_ = nullptr;
+    if (this != &ptr) {
+      reset(ptr.release());
+      deleter_ = std::move(ptr.deleter_);
+    }
     return *this;
   }
 
@@ -112,6 +129,7 @@ public:
 
   unique_ptr(unique_ptr&& ptr) noexcept
       : pointer_(ptr.pointer_)
+      , deleter_(std::move(ptr.deleter_))
   {
     ptr.pointer_ = nullptr;
   }
@@ -130,9 +148,8 @@ public:
 
   void swap(unique_ptr& other) noexcept
   {
-    T* tmp = pointer_;
-    pointer_ = other.pointer_;
-    other.pointer_ = tmp;
+    std::swap(pointer_, other.pointer_);
+    std::swap(deleter_, other.deleter_);
   }
 
   void reset(T* new_ptr = nullptr) noexcept
@@ -155,15 +172,64 @@ public:
   ~unique_ptr() { reset(); }
 };
 
+// Only holds a pointer and its deleter, neither of which refers back to it
+template<typename T, typename Deleter>
+struct is_trivially_relocatable<unique_ptr<T, Deleter>>
+    : is_trivially_relocatable<Deleter>
+{
+};
+
+// Instrumented builds count these under allocation_only<unique_ptr<T>>.
+// The delete goes through default_delete, which can't tell them apart from
+// pointers adopted from a plain new, so it doesn't report back.
 template<typename T, typename... Args>
 unique_ptr<T> make_unique(Args... args)
 {
-  return unique_ptr<T>(new T {std::forward<Args>(args)...});
+  unique_ptr<T> ptr(new T {std::forward<Args>(args)...});
+  instrumentation::on_allocate<instrumentation::allocation_only<unique_ptr<T>>>(
+      sizeof(T));
+  return ptr;
 }
 
 template<typename T>
 unique_ptr<T> make_unique()
 {
-  return unique_ptr<T>(new T {});
+  unique_ptr<T> ptr(new T {});
+  instrumentation::on_allocate<instrumentation::allocation_only<unique_ptr<T>>>(
+      sizeof(T));
+  return ptr;
+}
+
+// Array of count value-initialized elements taken from alloc, which gets
+// them back when the pointer lets go. Pair with aligned_allocator for
+// aligned or huge-page backed tables.
+template<typename T, typename Allocator>
+  requires std::is_unbounded_array_v<T>
+unique_ptr<T,
+           allocator_delete<typename allocator_traits<
+               Allocator>::template rebind_alloc<std::remove_extent_t<T>>>>
+allocate_unique(const Allocator& alloc, std::size_t count)
+{
+  using element = std::remove_extent_t<T>;
+  using element_allocator =
+      typename allocator_traits<Allocator>::template rebind_alloc<element>;
+  using alloc_traits = allocator_traits<element_allocator>;
+
+  element_allocator element_alloc(alloc);
+  element* ptr = alloc_traits::allocate(element_alloc, count);
+  std::size_t constructed = 0;
+  try {
+    for (; constructed < count; constructed++) {
+      alloc_traits::construct(element_alloc, ptr + constructed);
+    }
+  } catch (...) {
+    while (constructed-- > 0) {
+      alloc_traits::destroy(element_alloc, ptr + constructed);
+    }
+    alloc_traits::deallocate(element_alloc, ptr, count);
+    throw;
+  }
+  return unique_ptr<T, allocator_delete<element_allocator>>(
+      ptr, allocator_delete<element_allocator>(element_alloc, count));
 }
 }  // namespace steev
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "control_block.hpp"
+#include "memory/relocate.hpp"
 #include "shared_ptr.hpp"
+#include "thread_policy.hpp"
 
 namespace steev
 {
@@ -14,14 +16,16 @@ class bad_weak_ptr : public std::exception
   }
 };
 
-template<typename T>
+template<typename T, typename ThreadPolicy = thread_safe_counter>
 class weak_ptr
 {
+  using control_block = steev::control_block<ThreadPolicy>;
+
   T* pointer;
   control_block* ctrl;
 
 public:
-  explicit weak_ptr(const shared_ptr<T>& other) noexcept
+  explicit weak_ptr(const shared_ptr<T, ThreadPolicy>& other) noexcept
       : pointer(other.get())
       , ctrl(other.ctrl)
   {
@@ -93,18 +97,17 @@ public:
     return pointer == nullptr ? 0 : ctrl->get_refs();
   }
 
-  shared_ptr<T> lock() const
+  shared_ptr<T, ThreadPolicy> lock() const
   {
-    if (expired()) {
+    // Checking expired() first would race with the last owner letting go
+    if (pointer == nullptr || !ctrl->try_add_ref()) {
       throw bad_weak_ptr();
-    };
+    }
 
-    shared_ptr<T> shared;
+    shared_ptr<T, ThreadPolicy> shared;
     shared.pointer = pointer;
     shared.ctrl = ctrl;
 
-    ctrl->add_ref();
-
     return shared;
   }
 
@@ -127,4 +130,12 @@ private:
     }
   }
 };
+
+template<typename T>
+using local_weak_ptr = weak_ptr<T, thread_unsafe_counter>;
+
+template<typename T, typename ThreadPolicy>
+struct is_trivially_relocatable<weak_ptr<T, ThreadPolicy>> : std::true_type
+{
+};
 }  // namespace steev
@@ -1,3 +1,5 @@
+#include <compare>
+#include <limits>
 #include <stdexcept>
 
 #include "containers/array.hpp"
@@ -20,3 +22,64 @@ TEST_F(ArrayTest, Capacity)
 {
   EXPECT_GE(vec.capacity(), 5);
 }
+
+TEST_F(ArrayTest, AccessElements)
+{
+  EXPECT_EQ(vec[0], 1);
+  EXPECT_EQ(vec.at(4), 5);
+  EXPECT_EQ(vec.front(), 1);
+  EXPECT_EQ(vec.back(), 5);
+  EXPECT_THROW(static_cast<void>(vec.at(5)), std::out_of_range);
+}
+
+TEST_F(ArrayTest, Iterate)
+{
+  int sum = 0;
+  for (const auto& val : vec) {
+    sum += val;
+  }
+  EXPECT_EQ(sum, 15);
+}
+
+TEST_F(ArrayTest, Compare)
+{
+  steev::array<int, 5> same = {1, 2, 3, 4, 5};
+  steev::array<int, 5> larger = {1, 2, 3, 5, 0};
+  EXPECT_EQ(vec, same);
+  EXPECT_NE(vec, larger);
+  EXPECT_LT(vec, larger);
+  EXPECT_GT(larger, same);
+}
+
+TEST_F(ArrayTest, FindAndCount)
+{
+  EXPECT_EQ(find(vec, 3), vec.begin() + 2);
+  EXPECT_EQ(find(vec, 6), vec.end());
+  EXPECT_EQ(count(vec, 4), 1);
+  EXPECT_EQ(count(vec, 0), 0);
+}
+
+TEST(ArrayFillTest, Fill)
+{
+  steev::array<double, 37> values;
+  values.fill(0.5);
+  EXPECT_EQ(count(values, 0.5), 37);
+
+  // Unordered elements make the whole comparison unordered
+  steev::array<double, 37> other = values;
+  other[20] = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_NE(values, other);
+  EXPECT_EQ(values <=> other, std::partial_ordering::unordered);
+}
+
+TEST(ArrayFillTest, Constexpr)
+{
+  constexpr auto filled = []
+  {
+    steev::array<int, 4> values {};
+    values.fill(2);
+    return values;
+  }();
+  static_assert(filled == steev::array<int, 4> {2, 2, 2, 2});
+  static_assert(count(filled, 2) == 4);
+}
@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "containers/concurrent_vector.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(ConcurrentVectorTest, PushBackAndAccess)
+{
+  steev::concurrent_vector<int, 4> vec;
+  EXPECT_TRUE(vec.empty());
+  for (int i = 0; i < 100; i++) {
+    auto it = vec.push_back(i);
+    EXPECT_EQ(*it, i);
+  }
+  EXPECT_EQ(vec.size(), 100);
+  EXPECT_GE(vec.capacity(), 100);
+  EXPECT_EQ(vec[0], 0);
+  EXPECT_EQ(vec[3], 3);
+  EXPECT_EQ(vec[4], 4);
+  EXPECT_EQ(vec.at(99), 99);
+  EXPECT_THROW(static_cast<void>(vec.at(100)), std::out_of_range);
+}
+
+TEST(ConcurrentVectorTest, ElementsNeverMove)
+{
+  steev::concurrent_vector<std::string, 2> vec;
+  std::string* first = &*vec.emplace_back(32, 'a');
+  for (int i = 0; i < 1000; i++) {
+    vec.push_back(*first);
+  }
+  EXPECT_EQ(first, &vec[0]);
+  EXPECT_EQ(vec[1000], std::string(32, 'a'));
+}
+
+TEST(ConcurrentVectorTest, GrowBy)
+{
+  steev::concurrent_vector<int, 4> vec;
+  vec.push_back(1);
+  auto it = vec.grow_by(10, 7);
+  EXPECT_EQ(std::distance(vec.begin(), it), 1);
+  EXPECT_EQ(vec.size(), 11);
+  EXPECT_TRUE(std::all_of(it, vec.end(), [](int x) { return x == 7; }));
+
+  it = vec.grow_by(3);
+  EXPECT_EQ(*it, 0);
+  EXPECT_EQ(vec.size(), 14);
+
+  vec.grow_by(0);
+  EXPECT_EQ(vec.size(), 14);
+}
+
+TEST(ConcurrentVectorTest, ReserveAndClear)
+{
+  steev::concurrent_vector<std::unique_ptr<int>, 4> vec;
+  vec.reserve(30);
+  EXPECT_EQ(vec.capacity(), 32);
+  EXPECT_TRUE(vec.empty());
+  vec.emplace_back(std::make_unique<int>(1));
+  vec.clear();
+  EXPECT_TRUE(vec.empty());
+  EXPECT_EQ(vec.capacity(), 0);
+}
+
+TEST(ConcurrentVectorTest, IteratorIsForward)
+{
+  using Vector = steev::concurrent_vector<int, 4>;
+  static_assert(std::forward_iterator<Vector::iterator>);
+  static_assert(std::forward_iterator<Vector::const_iterator>);
+
+  Vector vec;
+  vec.grow_by(20, 1);
+  EXPECT_EQ(std::distance(vec.begin(), vec.end()), 20);
+  *std::next(vec.begin(), 9) = 5;
+
+  const auto& view = vec;
+  Vector::const_iterator it = std::next(vec.begin(), 9);
+  EXPECT_EQ(*it, 5);
+  EXPECT_EQ(std::count(view.begin(), view.end(), 1), 19);
+  EXPECT_EQ(Vector::iterator {}, vec.end());
+}
+
+namespace
+{
+// Throws from its constructor when asked to
+struct MaybeThrows
+{
+  int value;
+
+  explicit MaybeThrows(int v)
+      : value(v)
+  {
+    if (v < 0) {
+      throw std::runtime_error("negative");
+    }
+  }
+};
+}  // namespace
+
+// A constructor that throws leaves its slot empty and reaches the caller
+TEST(ConcurrentVectorTest, ThrowingConstructorLeavesHole)
+{
+  steev::concurrent_vector<MaybeThrows, 4> vec;
+  vec.emplace_back(1);
+  EXPECT_THROW(vec.emplace_back(-1), std::runtime_error);
+  vec.emplace_back(3);
+
+  EXPECT_EQ(vec.size(), 3);
+  EXPECT_EQ(vec.at(2).value, 3);
+  EXPECT_THROW(static_cast<void>(vec.at(1)), std::out_of_range);
+
+  std::vector<int> values;
+  for (const MaybeThrows& element : vec) {
+    values.push_back(element.value);
+  }
+  EXPECT_EQ(values, (std::vector<int> {1, 3}));
+}
+
+namespace
+{
+// Parks its constructor until released, standing in for a preempted
+// appender
+struct Stalls
+{
+  static inline std::atomic<bool> entered = false;
+  static inline std::atomic<bool> released = false;
+  int value;
+
+  Stalls(int v, bool stall)
+      : value(v)
+  {
+    if (stall) {
+      entered = true;
+      entered.notify_all();
+      released.wait(false);
+    }
+  }
+};
+}  // namespace
+
+// Other appenders finish while one is stuck constructing, and readers skip
+// the stuck slot until it is done
+TEST(ConcurrentVectorTest, StalledAppenderBlocksNoOne)
+{
+  constexpr int threads = 4;
+  constexpr int per_thread = 1000;
+  steev::concurrent_vector<Stalls, 4> vec;
+
+  std::thread stalled([&vec] { vec.emplace_back(-1, true); });
+  Stalls::entered.wait(false);
+
+  std::vector<std::thread> appenders;
+  for (int t = 0; t < threads; t++) {
+    appenders.emplace_back(
+        [&vec]
+        {
+          for (int i = 0; i < per_thread; i++) {
+            vec.emplace_back(i, false);
+          }
+        });
+  }
+  for (auto& appender : appenders) {
+    appender.join();
+  }
+
+  EXPECT_EQ(vec.size(), std::size_t {threads * per_thread + 1});
+  EXPECT_EQ(std::distance(vec.begin(), vec.end()), threads * per_thread);
+  EXPECT_THROW(static_cast<void>(vec.at(0)), std::out_of_range);
+
+  Stalls::released = true;
+  Stalls::released.notify_all();
+  stalled.join();
+  EXPECT_EQ(std::distance(vec.begin(), vec.end()), threads * per_thread + 1);
+  EXPECT_EQ(vec.at(0).value, -1);
+}
+
+// Every value pushed by every thread ends up in the vector exactly once
+TEST(ConcurrentVectorTest, ConcurrentPushBack)
+{
+  constexpr int threads = 8;
+  constexpr int per_thread = 20000;
+  steev::concurrent_vector<int> vec;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; t++) {
+    workers.emplace_back(
+        [&vec, t]
+        {
+          for (int i = 0; i < per_thread; i++) {
+            if (i % 100 == 0) {
+              vec.grow_by(2, t * per_thread + i);
+            } else {
+              vec.push_back(t * per_thread + i);
+            }
+          }
+        });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  ASSERT_EQ(vec.size(), std::size_t {threads * per_thread + threads * 200});
+  std::vector<int> values(vec.begin(), vec.end());
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  ASSERT_EQ(values.size(), std::size_t {threads * per_thread});
+  EXPECT_EQ(values.front(), 0);
+  EXPECT_EQ(values.back(), threads * per_thread - 1);
+}
+
+// Readers follow the writer through an index it publishes after each push
+TEST(ConcurrentVectorTest, ReadPublishedWhileAppending)
+{
+  constexpr std::size_t count = 50000;
+  steev::concurrent_vector<std::size_t> vec;
+  std::atomic<std::size_t> published = 0;
+
+  std::thread writer(
+      [&]
+      {
+        for (std::size_t i = 0; i < count; i++) {
+          vec.push_back(i * 3);
+          published.store(i + 1, std::memory_order_release);
+        }
+      });
+
+  std::vector<std::thread> readers;
+  std::atomic<bool> mismatch = false;
+  for (int r = 0; r < 3; r++) {
+    readers.emplace_back(
+        [&]
+        {
+          std::size_t seen = 0;
+          while (seen < count) {
+            seen = published.load(std::memory_order_acquire);
+            if (seen > 0 && vec[seen - 1] != (seen - 1) * 3) {
+              mismatch = true;
+            }
+          }
+        });
+  }
+
+  writer.join();
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_FALSE(mismatch);
+}
+
+// Readers walk [begin(), end()) while writers append, and only ever see
+// fully constructed elements
+TEST(ConcurrentVectorTest, IterateWhileAppending)
+{
+  constexpr int writers = 4;
+  constexpr int per_writer = 5000;
+  steev::concurrent_vector<std::string, 4> vec;
+  std::atomic<int> writers_done = 0;
+
+  std::vector<std::thread> threads;
+  for (int w = 0; w < writers; w++) {
+    threads.emplace_back(
+        [&vec, &writers_done, w]
+        {
+          for (int i = 0; i < per_writer; i++) {
+            if (i % 50 == 0) {
+              vec.grow_by(3, std::string(40, static_cast<char>('a' + w)));
+            } else {
+              vec.push_back(std::string(40, static_cast<char>('a' + w)));
+            }
+          }
+          writers_done.fetch_add(1, std::memory_order_release);
+        });
+  }
+
+  std::atomic<bool> torn = false;
+  for (int r = 0; r < 2; r++) {
+    threads.emplace_back(
+        [&]
+        {
+          while (writers_done.load(std::memory_order_acquire) < writers) {
+            std::size_t seen = 0;
+            for (const std::string& element : std::as_const(vec)) {
+              if (element.size() != 40 || element.front() != element.back()) {
+                torn = true;
+              }
+              seen++;
+            }
+            if (seen > vec.size()) {
+              torn = true;
+            }
+            std::this_thread::yield();
+          }
+        });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_FALSE(torn);
+  EXPECT_EQ(vec.size(), std::size_t {writers * (per_writer + 2 * 100)});
+}
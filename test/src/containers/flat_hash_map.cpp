@@ -0,0 +1,224 @@
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "containers/flat_hash_map.hpp"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// Lets string keys be looked up by string_view or literal without a copy
+struct string_hash
+{
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view key) const noexcept
+  {
+    return std::hash<std::string_view>()(key);
+  }
+};
+
+// Counts how often values of this type are copied and moved
+struct counted
+{
+  static inline int copies = 0;
+  static inline int moves = 0;
+
+  counted() = default;
+  counted(const counted&) { copies++; }
+  counted(counted&&) noexcept { moves++; }
+  counted& operator=(const counted&) = default;
+  counted& operator=(counted&&) noexcept = default;
+};
+}  // namespace
+
+class FlatHashMapTest : public ::testing::Test
+{
+protected:
+  steev::flat_hash_map<std::string, int, string_hash, std::equal_to<>> map =
+      {{"one", 1}, {"two", 2}, {"three", 3}};
+};
+
+TEST_F(FlatHashMapTest, Lookup)
+{
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_EQ(map.at("two"), 2);
+  EXPECT_TRUE(map.contains(std::string_view("three")));
+  EXPECT_FALSE(map.contains("four"));
+  EXPECT_EQ(map.count(std::string("one")), 1);
+  EXPECT_EQ(map.find("four"), map.end());
+  EXPECT_THROW(static_cast<void>(map.at("four")), std::out_of_range);
+}
+
+TEST_F(FlatHashMapTest, Insert)
+{
+  auto [it, inserted] = map.insert({"four", 4});
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(it->second, 4);
+
+  std::tie(it, inserted) = map.insert({"four", 40});
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(it->second, 4);
+
+  std::tie(it, inserted) = map.insert_or_assign("four", 44);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(map.at("four"), 44);
+
+  EXPECT_TRUE(map.emplace("five", 5).second);
+  EXPECT_FALSE(map.try_emplace("five", 50).second);
+  map["six"] = 6;
+  map["one"]++;
+  EXPECT_EQ(map.size(), 6);
+  EXPECT_EQ(map.at("one"), 2);
+  EXPECT_EQ(map.at("six"), 6);
+}
+
+TEST_F(FlatHashMapTest, Erase)
+{
+  EXPECT_EQ(map.erase("two"), 1);
+  EXPECT_EQ(map.erase("two"), 0);
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_FALSE(map.contains("two"));
+
+  map.erase(map.find("one"));
+  EXPECT_EQ(map.size(), 1);
+  EXPECT_EQ(map.begin()->first, "three");
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST_F(FlatHashMapTest, Iterate)
+{
+  int sum = 0;
+  for (auto& [key, value] : map) {
+    sum += value;
+    value *= 10;
+  }
+  EXPECT_EQ(sum, 6);
+
+  const auto& view = map;
+  sum = 0;
+  for (const auto& [key, value] : view) {
+    sum += value;
+  }
+  EXPECT_EQ(sum, 60);
+  EXPECT_EQ(std::distance(view.begin(), view.end()), 3);
+}
+
+TEST_F(FlatHashMapTest, CopyAndMove)
+{
+  auto copy = map;
+  EXPECT_EQ(copy, map);
+  copy["one"] = 100;
+  EXPECT_NE(copy, map);
+
+  auto moved = std::move(copy);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.at("one"), 100);
+
+  map = moved;
+  EXPECT_EQ(map, moved);
+}
+
+// A copy builds each element once, straight in its slot
+TEST(FlatHashMap, CopyBuildsInPlace)
+{
+  steev::flat_hash_map<int, counted> map;
+  for (int i = 0; i < 100; i++) {
+    map[i];
+  }
+  counted::copies = 0;
+  counted::moves = 0;
+  auto copy = map;
+  EXPECT_EQ(copy.size(), 100);
+  EXPECT_EQ(counted::copies, 100);
+  EXPECT_EQ(counted::moves, 0);
+}
+
+// Every insert here passes a reference into the table, and some of them
+// land right at the growth threshold
+TEST(FlatHashMap, InsertOwnElementWhileGrowing)
+{
+  steev::flat_hash_map<int, std::string> map;
+  map[0] = std::string(40, 'x');
+  for (int i = 1; i < 200; i++) {
+    map.try_emplace(i, map.at(i - 1));
+  }
+  for (int i = 0; i < 200; i++) {
+    ASSERT_EQ(map.at(i), std::string(40, 'x'));
+  }
+
+  steev::flat_hash_map<int, int> chain = {{0, 1}};
+  for (int i = 0; i < 200; i++) {
+    chain[chain[i]] = i + 2;
+  }
+  EXPECT_EQ(chain.size(), 201);
+  EXPECT_EQ(chain.at(200), 201);
+}
+
+TEST(FlatHashMap, ReserveAndRehash)
+{
+  steev::flat_hash_map<int, int> map;
+  EXPECT_EQ(map.capacity(), 0);
+  map.reserve(100);
+  std::size_t reserved = map.capacity();
+  EXPECT_GE(reserved * 7 / 8, 100);
+  for (int i = 0; i < 100; i++) {
+    map[i] = i;
+  }
+  EXPECT_EQ(map.capacity(), reserved);
+  EXPECT_LE(map.load_factor(), 0.875F);
+
+  for (int i = 0; i < 90; i++) {
+    map.erase(i);
+  }
+  map.rehash(0);
+  EXPECT_EQ(map.capacity(), 16);
+  EXPECT_EQ(map.size(), 10);
+  EXPECT_EQ(map.at(95), 95);
+}
+
+// Churn leaves tombstones, which get cleared instead of growing the table
+TEST(FlatHashMap, InsertEraseChurn)
+{
+  steev::flat_hash_map<int, int> map;
+  for (int i = 0; i < 100000; i++) {
+    map[i] = i;
+    if (i >= 50) {
+      EXPECT_EQ(map.erase(i - 50), 1);
+    }
+  }
+  EXPECT_EQ(map.size(), 50);
+  EXPECT_LE(map.capacity(), 128);
+}
+
+// Random inserts and erases agree with std::map
+TEST(FlatHashMap, MatchesStdMap)
+{
+  std::mt19937 engine(42);
+  std::uniform_int_distribution<int> keys(0, 2000);
+  steev::flat_hash_map<int, std::unique_ptr<int>> map;
+  std::map<int, int> expected;
+  for (int i = 0; i < 20000; i++) {
+    int key = keys(engine);
+    if (i % 3 == 0) {
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+    } else {
+      bool inserted = map.try_emplace(key, std::make_unique<int>(i)).second;
+      EXPECT_EQ(inserted, expected.emplace(key, i).second);
+    }
+  }
+  ASSERT_EQ(map.size(), expected.size());
+  for (const auto& [key, value] : expected) {
+    auto it = map.find(key);
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(*it->second, value);
+  }
+}
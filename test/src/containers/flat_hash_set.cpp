@@ -0,0 +1,80 @@
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+#include "containers/flat_hash_set.hpp"
+
+#include <gtest/gtest.h>
+
+class FlatHashSetTest : public ::testing::Test
+{
+protected:
+  steev::flat_hash_set<std::string> set = {"one", "two", "three"};
+};
+
+TEST_F(FlatHashSetTest, InsertAndLookup)
+{
+  EXPECT_EQ(set.size(), 3);
+  EXPECT_TRUE(set.contains("two"));
+  EXPECT_FALSE(set.insert("two").second);
+
+  auto [it, inserted] = set.insert("four");
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*it, "four");
+  EXPECT_TRUE(set.emplace(std::size_t {3}, 'x').second);
+  EXPECT_TRUE(set.contains("xxx"));
+  EXPECT_EQ(set.size(), 5);
+}
+
+TEST_F(FlatHashSetTest, EraseWhileIterating)
+{
+  for (auto it = set.begin(); it != set.end();) {
+    if (it->size() == 3) {
+      it = set.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  EXPECT_EQ(set.size(), 1);
+  EXPECT_EQ(*set.begin(), "three");
+}
+
+TEST_F(FlatHashSetTest, ElementsAreConst)
+{
+  using Set = decltype(set);
+  static_assert(std::is_same_v<Set::iterator, Set::const_iterator>);
+  using Reference = decltype(*set.begin());
+  static_assert(std::is_const_v<std::remove_reference_t<Reference>>);
+}
+
+TEST(FlatHashSet, ManyElements)
+{
+  steev::flat_hash_set<int> set;
+  for (int i = 0; i < 10000; i++) {
+    set.insert(i * 7);
+  }
+  EXPECT_EQ(set.size(), 10000);
+  int found = 0;
+  for (int i = 0; i < 70000; i++) {
+    found += set.contains(i) ? 1 : 0;
+  }
+  EXPECT_EQ(found, 10000);
+
+  auto copy = set;
+  EXPECT_EQ(copy, set);
+  copy.erase(0);
+  EXPECT_NE(copy, set);
+}
+
+TEST(FlatHashSet, InsertOwnElementWhileGrowing)
+{
+  steev::flat_hash_set<std::string> set;
+  std::string last;
+  for (int i = 0; i < 200; i++) {
+    last = std::string(40, 'a') + std::to_string(i);
+    set.insert(last);
+    set.insert(*set.find(last));
+  }
+  EXPECT_EQ(set.size(), 200);
+  EXPECT_TRUE(set.contains(last));
+}
@@ -0,0 +1,184 @@
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "containers/flat_map.hpp"
+
+#include <gtest/gtest.h>
+
+// Both layouts have to give the same answers
+template<typename Layout>
+class FlatMapTest : public ::testing::Test
+{
+};
+
+using Layouts = ::testing::Types<steev::sorted_layout, steev::eytzinger_layout>;
+TYPED_TEST_SUITE(FlatMapTest, Layouts);
+
+TYPED_TEST(FlatMapTest, BuildsFromUnsortedVectors)
+{
+  steev::vector<int> keys = {3, 1, 2, 1};
+  steev::vector<std::string> values = {"three", "one", "two", "uno"};
+  steev::flat_map<int, std::string, std::less<int>, TypeParam> map(keys,
+                                                                   values);
+
+  // A repeated key keeps the first value it was given
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_EQ(map.keys(), (steev::vector<int> {1, 2, 3}));
+  EXPECT_EQ(map.values(),
+            (steev::vector<std::string> {"one", "two", "three"}));
+  EXPECT_EQ(map.at(2), "two");
+  EXPECT_THROW(map.at(4), std::out_of_range);
+  EXPECT_EQ(map.find(4), map.end());
+  EXPECT_EQ(map.lower_bound(4), map.end());
+  EXPECT_EQ((*map.upper_bound(1)).first, 2);
+
+  steev::vector<std::string> short_values = {"one"};
+  using Map = decltype(map);
+  EXPECT_THROW(Map(keys, short_values), std::invalid_argument);
+}
+
+TYPED_TEST(FlatMapTest, InsertAndErase)
+{
+  steev::flat_map<std::string, int, std::less<>, TypeParam> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.insert({"b", 2}).second);
+  EXPECT_TRUE(map.try_emplace("a", 1).second);
+  EXPECT_FALSE(map.try_emplace("a", 10).second);
+  map["c"] = 3;
+  map["a"] += 10;
+  EXPECT_EQ(map.at("a"), 11);
+
+  // std::less<> lets a string literal look up without a temporary
+  EXPECT_TRUE(map.contains("c"));
+  EXPECT_EQ(map.find("b")->second, 2);
+
+  EXPECT_EQ(map.erase("b"), 1);
+  EXPECT_EQ(map.erase("b"), 0);
+  auto it = map.erase(map.begin());
+  EXPECT_EQ(it->first, "c");
+  EXPECT_EQ(map.size(), 1);
+  map.clear();
+  EXPECT_FALSE(map.contains("c"));
+}
+
+TYPED_TEST(FlatMapTest, MatchesStdMap)
+{
+  std::mt19937 random(11);
+  std::uniform_int_distribution<int> value(0, 2000);
+  std::map<int, int> expected;
+  steev::flat_map<int, int, std::less<int>, TypeParam> map;
+  for (int i = 0; i < 1000; i++) {
+    int key = value(random);
+    expected.try_emplace(key, i);
+    map.try_emplace(key, i);
+  }
+
+  ASSERT_EQ(map.size(), expected.size());
+  ASSERT_TRUE(std::equal(map.begin(),
+                         map.end(),
+                         expected.begin(),
+                         [](auto lhs, const auto& rhs)
+                         {
+                           return lhs.first == rhs.first
+                               && lhs.second == rhs.second;
+                         }));
+  for (int key = -1; key <= 2001; key++) {
+    auto lower = expected.lower_bound(key);
+    ASSERT_EQ(map.contains(key), expected.contains(key));
+    ASSERT_EQ(map.lower_bound(key) - map.begin(),
+              std::distance(expected.begin(), lower));
+  }
+}
+
+TEST(FlatMap, IteratorsModifyValues)
+{
+  steev::flat_map<int, int> map = {{2, 20}, {1, 10}, {3, 30}};
+  for (auto [key, value] : map) {
+    value += key;
+  }
+  EXPECT_EQ(map.values(), (steev::vector<int> {11, 22, 33}));
+
+  const auto& view = map;
+  steev::flat_map<int, int>::const_iterator it = map.begin();
+  EXPECT_EQ(it, view.begin());
+  EXPECT_EQ(view.end() - it, 3);
+  EXPECT_EQ(it[2].second, 33);
+#ifdef __cpp_lib_ranges_zip
+  static_assert(std::random_access_iterator<decltype(it)>);
+#endif
+}
+
+TEST(FlatMap, SortedUniqueSkipsTheSort)
+{
+  steev::flat_map<int, char> map(steev::sorted_unique,
+                                 steev::vector<int> {1, 2, 3},
+                                 steev::vector<char> {'a', 'b', 'c'});
+  EXPECT_EQ(map.at(3), 'c');
+  EXPECT_EQ(map, (steev::flat_map<int, char> {{3, 'c'}, {1, 'a'}, {2, 'b'}}));
+}
+
+namespace
+{
+// Copying into the search tree throws while armed; the keys themselves
+// are only ever moved
+struct FragileKey
+{
+  static inline bool armed = false;
+  int value = 0;
+
+  FragileKey() = default;
+
+  explicit FragileKey(int v)
+      : value(v)
+  {
+  }
+
+  FragileKey(const FragileKey&) = default;
+  FragileKey(FragileKey&&) noexcept = default;
+  FragileKey& operator=(FragileKey&&) noexcept = default;
+
+  FragileKey& operator=(const FragileKey& other)
+  {
+    if (armed) {
+      throw std::runtime_error("copy");
+    }
+    value = other.value;
+    return *this;
+  }
+
+  friend bool operator<(const FragileKey& lhs, const FragileKey& rhs)
+  {
+    return lhs.value < rhs.value;
+  }
+};
+}  // namespace
+
+// A tree that fails to rebuild falls back to searching the sorted keys
+TEST(FlatMap, FailedIndexBuildKeepsLookupsRight)
+{
+  steev::flat_map<FragileKey, int, std::less<>, steev::eytzinger_layout> map;
+  for (int i = 0; i < 10; i += 2) {
+    map.try_emplace(FragileKey {i}, i);
+  }
+
+  FragileKey::armed = true;
+  EXPECT_TRUE(map.try_emplace(FragileKey {5}, 5).second);
+  FragileKey::armed = false;
+  for (int i : {0, 2, 4, 5, 6, 8}) {
+    ASSERT_NE(map.find(FragileKey {i}), map.end());
+    EXPECT_EQ((*map.find(FragileKey {i})).second, i);
+  }
+  EXPECT_EQ(map.find(FragileKey {3}), map.end());
+
+  FragileKey::armed = true;
+  EXPECT_EQ(map.erase(FragileKey {4}), 1);
+  FragileKey::armed = false;
+  EXPECT_EQ(map.find(FragileKey {4}), map.end());
+  EXPECT_NE(map.find(FragileKey {6}), map.end());
+}
@@ -0,0 +1,104 @@
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+
+#include "containers/flat_set.hpp"
+
+#include <gtest/gtest.h>
+
+// Both layouts have to give the same answers
+template<typename Layout>
+class FlatSetTest : public ::testing::Test
+{
+};
+
+using Layouts = ::testing::Types<steev::sorted_layout, steev::eytzinger_layout>;
+TYPED_TEST_SUITE(FlatSetTest, Layouts);
+
+TYPED_TEST(FlatSetTest, BuildsSortedAndUnique)
+{
+  steev::flat_set<int, std::less<int>, TypeParam> set = {5, 1, 4, 1, 5, 9, 2};
+  EXPECT_EQ(set.size(), 5);
+  EXPECT_EQ(set.keys(), (steev::vector<int> {1, 2, 4, 5, 9}));
+  EXPECT_TRUE(set.contains(4));
+  EXPECT_FALSE(set.contains(3));
+  EXPECT_EQ(*set.lower_bound(3), 4);
+  EXPECT_EQ(*set.upper_bound(4), 5);
+  EXPECT_EQ(set.lower_bound(10), set.end());
+  EXPECT_EQ(set.find(0), set.end());
+}
+
+TYPED_TEST(FlatSetTest, InsertAndErase)
+{
+  steev::flat_set<std::string, std::less<>, TypeParam> set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(set.find("a"), set.end());
+  EXPECT_TRUE(set.insert("b").second);
+  EXPECT_TRUE(set.insert("a").second);
+  EXPECT_FALSE(set.insert("b").second);
+  EXPECT_TRUE(set.insert("c").second);
+  EXPECT_EQ(*set.begin(), "a");
+
+  // std::less<> lets a string literal look up without a temporary
+  EXPECT_TRUE(set.contains("c"));
+  EXPECT_EQ(set.erase("b"), 1);
+  EXPECT_EQ(set.erase("b"), 0);
+  EXPECT_EQ(*set.erase(set.begin()), "c");
+  EXPECT_EQ(set.size(), 1);
+  set.clear();
+  EXPECT_FALSE(set.contains("c"));
+}
+
+TYPED_TEST(FlatSetTest, MatchesStdSet)
+{
+  std::mt19937 random(7);
+  std::uniform_int_distribution<int> value(0, 2000);
+  steev::vector<int> keys;
+  std::set<int> expected;
+  for (int i = 0; i < 1000; i++) {
+    int key = value(random);
+    keys.push_back(key);
+    expected.insert(key);
+  }
+
+  steev::flat_set<int, std::less<int>, TypeParam> set(keys);
+  ASSERT_EQ(set.size(), expected.size());
+  for (int key = -1; key <= 2001; key++) {
+    auto lower = expected.lower_bound(key);
+    auto upper = expected.upper_bound(key);
+    ASSERT_EQ(set.contains(key), expected.contains(key));
+    ASSERT_EQ(set.lower_bound(key) - set.begin(),
+              std::distance(expected.begin(), lower));
+    ASSERT_EQ(set.upper_bound(key) - set.begin(),
+              std::distance(expected.begin(), upper));
+  }
+}
+
+// The Eytzinger tree is only complete for some sizes
+TYPED_TEST(FlatSetTest, EverySmallSize)
+{
+  for (int size = 0; size < 40; size++) {
+    steev::flat_set<int, std::less<int>, TypeParam> set;
+    for (int key = 0; key < size; key++) {
+      set.insert(2 * key);
+    }
+    ASSERT_EQ(set.upper_bound(-1), set.begin());
+    ASSERT_EQ(set.lower_bound(2 * size), set.end());
+    for (int key = 0; key < 2 * size; key++) {
+      ASSERT_EQ(set.lower_bound(key) - set.begin(), (key + 1) / 2);
+      ASSERT_EQ(set.upper_bound(key) - set.begin(), key / 2 + 1);
+    }
+  }
+}
+
+TEST(FlatSet, SortedUniqueSkipsTheSort)
+{
+  steev::vector<int> keys = {9, 5, 1};
+  steev::flat_set<int, std::greater<int>> set(steev::sorted_unique, keys);
+  EXPECT_EQ(set.keys(), keys);
+  EXPECT_TRUE(set.contains(5));
+  EXPECT_EQ(*set.lower_bound(6), 5);
+  EXPECT_EQ(set, (steev::flat_set<int, std::greater<int>> {1, 9, 5, 9}));
+}
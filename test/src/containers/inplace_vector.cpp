@@ -0,0 +1,122 @@
+#include <stdexcept>
+#include <string>
+
+#include "containers/inplace_vector.hpp"
+
+#include <gtest/gtest.h>
+
+class InplaceVectorTest : public ::testing::Test
+{
+protected:
+  steev::inplace_vector<int, 8> vec = {1, 2, 3, 4, 5};
+};
+
+TEST_F(InplaceVectorTest, SizeAndCapacity)
+{
+  EXPECT_EQ(vec.size(), 5);
+  EXPECT_EQ(vec.capacity(), 8);
+  EXPECT_FALSE(vec.empty());
+  EXPECT_FALSE(vec.full());
+}
+
+TEST_F(InplaceVectorTest, StorageIsInObject)
+{
+  static_assert(sizeof(steev::inplace_vector<int, 8>)
+                == sizeof(std::size_t) + 8 * sizeof(int));
+  auto* begin = reinterpret_cast<const char*>(&vec);
+  auto* element = reinterpret_cast<const char*>(vec.data());
+  EXPECT_GE(element, begin);
+  EXPECT_LT(element, begin + sizeof(vec));
+}
+
+TEST_F(InplaceVectorTest, PushBackUntilFull)
+{
+  vec.push_back(6);
+  vec.emplace_back(7);
+  vec.push_back(8);
+  EXPECT_TRUE(vec.full());
+  EXPECT_THROW(vec.push_back(9), std::length_error);
+  EXPECT_EQ(vec.try_push_back(9), nullptr);
+  EXPECT_EQ(vec.back(), 8);
+}
+
+TEST_F(InplaceVectorTest, TryPushBack)
+{
+  int* slot = vec.try_push_back(6);
+  ASSERT_NE(slot, nullptr);
+  EXPECT_EQ(*slot, 6);
+  EXPECT_EQ(vec.size(), 6);
+}
+
+TEST_F(InplaceVectorTest, PopBack)
+{
+  vec.pop_back();
+  EXPECT_EQ(vec.back(), 4);
+  vec.clear();
+  EXPECT_THROW(vec.pop_back(), std::runtime_error);
+}
+
+TEST_F(InplaceVectorTest, InsertAndErase)
+{
+  auto it = vec.insert(vec.begin() + 1, 10);
+  EXPECT_EQ(*it, 10);
+  it = vec.erase(vec.begin() + 3);
+  EXPECT_EQ(*it, 4);
+  EXPECT_EQ(vec, (steev::inplace_vector<int, 8> {1, 10, 2, 4, 5}));
+}
+
+TEST_F(InplaceVectorTest, Resize)
+{
+  vec.resize(8);
+  EXPECT_EQ(vec[7], 0);
+  EXPECT_THROW(vec.resize(9), std::length_error);
+  vec.resize(2);
+  EXPECT_EQ(vec, (steev::inplace_vector<int, 8> {1, 2}));
+}
+
+TEST_F(InplaceVectorTest, AccessOutOfBounds)
+{
+  EXPECT_THROW(static_cast<void>(vec.at(5)), std::out_of_range);
+}
+
+TEST(InplaceVectorNonTrivialTest, Strings)
+{
+  steev::inplace_vector<std::string, 4> strings;
+  strings.emplace_back(3, 'a');
+  strings.push_back("b");
+  strings.insert(strings.begin(), std::string("front"));
+  EXPECT_EQ(strings.size(), 3);
+  EXPECT_EQ(strings[0], "front");
+  EXPECT_EQ(strings[1], "aaa");
+
+  auto copy = strings;
+  auto moved = std::move(strings);
+  EXPECT_TRUE(strings.empty());
+  EXPECT_EQ(copy, moved);
+
+  copy.swap(strings);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(strings[2], "b");
+}
+
+constexpr int constexpr_sum()
+{
+  steev::inplace_vector<int, 6> values;
+  for (int i = 1; i <= 5; i++) {
+    values.push_back(i);
+  }
+  values.insert(values.begin(), 10);
+  values.erase(values.begin() + 1);
+  values.pop_back();
+
+  int sum = 0;
+  for (int value : values) {
+    sum += value;
+  }
+  return sum;
+}
+
+TEST(InplaceVectorConstexprTest, Operations)
+{
+  static_assert(constexpr_sum() == 10 + 2 + 3 + 4);
+}
@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "containers/mmap_vector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+namespace
+{
+struct Record
+{
+  std::int64_t id;
+  double value;
+};
+
+template<typename Vector>
+concept changeable = requires(Vector& vector) {
+  vector.push_back({});
+  vector.reserve(1);
+  vector.clear();
+};
+}  // namespace
+
+class MmapVectorTest : public ::testing::Test
+{
+protected:
+  std::filesystem::path path;
+
+  void SetUp() override
+  {
+    const auto* test = ::testing::UnitTest::GetInstance()->current_test_info();
+    path = std::filesystem::temp_directory_path()
+        / ("steev_mmap_vector_" + std::to_string(::getpid()) + "_"
+           + test->name());
+    std::filesystem::remove(path);
+  }
+
+  void TearDown() override { std::filesystem::remove(path); }
+
+  void write_records(std::size_t count)
+  {
+    steev::mmap_vector<Record> records(path);
+    for (std::size_t i = 0; i < count; i++) {
+      records.push_back(
+          {static_cast<std::int64_t>(i), 0.5 * static_cast<double>(i)});
+    }
+  }
+};
+
+TEST_F(MmapVectorTest, CreatesEmptyFile)
+{
+  steev::mmap_vector<Record> records(path);
+  EXPECT_TRUE(records.is_open());
+  EXPECT_TRUE(records.empty());
+  EXPECT_EQ(records.begin(), records.end());
+  EXPECT_TRUE(std::filesystem::exists(path));
+}
+
+// Growing remaps, but the file ends up exactly size() elements long
+TEST_F(MmapVectorTest, GrowsAndTruncatesOnClose)
+{
+  steev::mmap_vector<Record> records(path);
+  for (std::int64_t i = 0; i < 10000; i++) {
+    records.push_back({i, 0.0});
+  }
+  EXPECT_EQ(records.size(), 10000);
+  EXPECT_GE(records.capacity(), 10000);
+  EXPECT_EQ(records[9999].id, 9999);
+
+  records.close();
+  EXPECT_FALSE(records.is_open());
+  EXPECT_EQ(std::filesystem::file_size(path), 10000 * sizeof(Record));
+}
+
+TEST_F(MmapVectorTest, ReopenReadOnly)
+{
+  write_records(5000);
+
+  steev::mmap_vector<const Record> records(path);
+  records.advise(steev::mmap_advice::sequential);
+  ASSERT_EQ(records.size(), 5000);
+
+  std::int64_t expected = 0;
+  for (const Record& record : records) {
+    EXPECT_EQ(record.id, expected);
+    expected++;
+  }
+  EXPECT_EQ(records.at(4999).value, 0.5 * 4999);
+  EXPECT_THROW(static_cast<void>(records.at(5000)), std::out_of_range);
+}
+
+TEST_F(MmapVectorTest, ClosedRejectsChanges)
+{
+  steev::mmap_vector<Record> closed;
+  EXPECT_THROW(closed.push_back({}), std::logic_error);
+  EXPECT_THROW(closed.reserve(100), std::logic_error);
+  EXPECT_THROW(closed.clear(), std::logic_error);
+}
+
+// The mapping is read-only, so a read-only vector has no way to write to it
+TEST_F(MmapVectorTest, ReadOnlyGivesConstAccessOnly)
+{
+  using ReadOnly = steev::mmap_vector<const Record>;
+  static_assert(std::is_same_v<decltype(std::declval<ReadOnly&>()[0]),
+                               const Record&>);
+  static_assert(std::is_same_v<decltype(*std::declval<ReadOnly&>().begin()),
+                               const Record&>);
+  static_assert(changeable<steev::mmap_vector<Record>>);
+  static_assert(!changeable<ReadOnly>);
+
+  write_records(3);
+
+  ReadOnly records(path);
+  EXPECT_EQ(records[1].id, 1);
+  EXPECT_EQ(records.at(2).id, 2);
+  EXPECT_EQ(records.back().id, 2);
+  auto found = std::ranges::find(records, 1, &Record::id);
+  EXPECT_EQ(found - records.begin(), 1);
+}
+
+TEST_F(MmapVectorTest, AppendToExistingFile)
+{
+  write_records(10);
+  {
+    steev::mmap_vector<Record> records(path);
+    records.push_back(records[0]);
+    records.flush();
+  }
+
+  steev::mmap_vector<const Record> records(path);
+  ASSERT_EQ(records.size(), 11);
+  EXPECT_EQ(records.back().id, 0);
+}
+
+TEST_F(MmapVectorTest, ResizeAndShrink)
+{
+  steev::mmap_vector<std::uint32_t> values(path);
+  values.resize(3000);
+  for (auto& value : values) {
+    value = 7;
+  }
+
+  // The bytes past size() still hold the old elements until resize zeroes
+  // them
+  values.resize(10);
+  values.resize_for_overwrite(20);
+  EXPECT_EQ(values[15], 7);
+  values.resize(10);
+  values.resize(20);
+  EXPECT_EQ(values[15], 0);
+
+  values.shrink_to_fit();
+  EXPECT_LT(values.capacity(), 3000);
+  EXPECT_EQ(values.size(), 20);
+  EXPECT_EQ(values[9], 7);
+
+  values.clear();
+  values.shrink_to_fit();
+  EXPECT_EQ(values.capacity(), 0);
+  EXPECT_EQ(values.data(), nullptr);
+  values.push_back(1);
+  EXPECT_EQ(values.front(), 1);
+}
+
+TEST_F(MmapVectorTest, Move)
+{
+  write_records(4);
+
+  steev::mmap_vector<const Record> first(path);
+  steev::mmap_vector<const Record> second(std::move(first));
+  EXPECT_FALSE(first.is_open());
+  EXPECT_EQ(second.size(), 4);
+
+  first = std::move(second);
+  EXPECT_EQ(first.size(), 4);
+  EXPECT_FALSE(second.is_open());
+}
+
+TEST_F(MmapVectorTest, BadFiles)
+{
+  EXPECT_THROW(steev::mmap_vector<const Record> {path}, std::system_error);
+
+  std::ofstream(path, std::ios::binary) << "odd";
+  EXPECT_THROW(steev::mmap_vector<const Record> {path}, std::runtime_error);
+}
+
+// A failed open must not cut the file back to the empty size()
+TEST_F(MmapVectorTest, FailedOpenKeepsFile)
+{
+  std::ofstream(path, std::ios::binary) << "eleven byte";
+  EXPECT_THROW(steev::mmap_vector<int> {path}, std::runtime_error);
+  EXPECT_EQ(std::filesystem::file_size(path), 11);
+}
@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "containers/ring_buffer.hpp"
+
+#include <gtest/gtest.h>
+
+// Both rings share the single-threaded behaviour
+template<typename Ring>
+class RingBufferTest : public ::testing::Test
+{
+protected:
+  Ring queue;
+};
+
+using Rings = ::testing::Types<steev::spsc_ring<std::string, 4>,
+                               steev::mpmc_ring<std::string, 4>>;
+TYPED_TEST_SUITE(RingBufferTest, Rings);
+
+TYPED_TEST(RingBufferTest, PushAndPopInOrder)
+{
+  auto& ring = this->queue;
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(ring.capacity(), 4);
+  EXPECT_TRUE(ring.try_push("one"));
+  EXPECT_TRUE(ring.try_emplace(std::size_t {3}, 'x'));
+  EXPECT_EQ(ring.size(), 2);
+
+  std::string out;
+  ASSERT_TRUE(ring.try_pop(out));
+  EXPECT_EQ(out, "one");
+  ASSERT_TRUE(ring.try_pop(out));
+  EXPECT_EQ(out, "xxx");
+  EXPECT_FALSE(ring.try_pop(out));
+}
+
+TYPED_TEST(RingBufferTest, FullRingRejectsPush)
+{
+  auto& ring = this->queue;
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(ring.try_push(std::to_string(i)));
+  }
+  EXPECT_FALSE(ring.try_push("full"));
+
+  // Wrapping around reuses the freed slots
+  std::string out;
+  for (int lap = 0; lap < 10; lap++) {
+    ASSERT_TRUE(ring.try_pop(out));
+    EXPECT_TRUE(ring.try_push(out));
+  }
+  EXPECT_EQ(ring.size(), 4);
+}
+
+TYPED_TEST(RingBufferTest, Batches)
+{
+  auto& ring = this->queue;
+  std::vector<std::string> in = {"a", "b", "c", "d", "e", "f"};
+  EXPECT_EQ(ring.push_batch(in.begin(), in.size()), 4);
+  EXPECT_EQ(ring.push_batch(in.begin(), 2), 0);
+
+  std::string out[3];
+  EXPECT_EQ(ring.pop_batch(out, 3), 3);
+  EXPECT_EQ(out[0], "a");
+  EXPECT_EQ(out[2], "c");
+
+  EXPECT_EQ(ring.push_batch(in.begin() + 4, 2), 2);
+  std::vector<std::string> rest;
+  EXPECT_EQ(ring.pop_batch(std::back_inserter(rest), 10), 3);
+  EXPECT_EQ(rest, (std::vector<std::string> {"d", "e", "f"}));
+}
+
+// Elements still queued are destroyed with the ring
+TYPED_TEST(RingBufferTest, DestroysQueuedElements)
+{
+  auto counted = std::make_shared<int>(0);
+  {
+    using Ring = std::conditional_t<
+        std::is_same_v<TypeParam, steev::spsc_ring<std::string, 4>>,
+        steev::spsc_ring<std::shared_ptr<int>, 4>,
+        steev::mpmc_ring<std::shared_ptr<int>, 4>>;
+    Ring ring;
+    ring.try_push(counted);
+    ring.try_push(counted);
+    std::shared_ptr<int> out;
+    ring.try_pop(out);
+    ring.try_push(counted);
+    EXPECT_EQ(counted.use_count(), 4);
+  }
+  EXPECT_EQ(counted.use_count(), 1);
+}
+
+TEST(SpscRingTest, ProducerConsumer)
+{
+  constexpr int count = 50000;
+  steev::spsc_ring<int, 256> ring;
+
+  std::thread producer(
+      [&ring]
+      {
+        int batch[8];
+        for (int i = 0; i < count;) {
+          if (i % 3 == 0) {
+            std::iota(batch, batch + 8, i);
+            i += static_cast<int>(ring.push_batch(batch, 8));
+          } else if (ring.try_push(i)) {
+            i++;
+          } else {
+            std::this_thread::yield();
+          }
+        }
+      });
+
+  int expected = 0;
+  bool ordered = true;
+  int batch[16];
+  while (expected < count) {
+    std::size_t popped = ring.pop_batch(batch, 16);
+    if (popped == 0) {
+      std::this_thread::yield();
+    }
+    for (std::size_t i = 0; i < popped; i++) {
+      ordered = ordered && batch[i] == expected;
+      expected++;
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(ring.empty());
+}
+
+// Every pushed value comes out exactly once, and each producer's values
+// come out in the order it pushed them
+TEST(MpmcRingTest, ManyProducersAndConsumers)
+{
+  constexpr int producers = 4;
+  constexpr int consumers = 4;
+  constexpr int per_producer = 10000;
+  steev::mpmc_ring<int, 64> ring;
+  std::atomic<int> remaining = producers * per_producer;
+  std::vector<std::atomic<int>> seen(producers * per_producer);
+  std::atomic<bool> ordered = true;
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; p++) {
+    threads.emplace_back(
+        [&ring, p]
+        {
+          for (int i = 0; i < per_producer;) {
+            int batch[4];
+            std::iota(batch, batch + 4, p * per_producer + i);
+            auto wanted = static_cast<std::size_t>(
+                std::min(4, per_producer - i));
+            std::size_t pushed = ring.push_batch(batch, wanted);
+            if (pushed == 0) {
+              std::this_thread::yield();
+            }
+            i += static_cast<int>(pushed);
+          }
+        });
+  }
+  for (int c = 0; c < consumers; c++) {
+    threads.emplace_back(
+        [&, c]
+        {
+          std::vector<int> last(producers, -1);
+          int batch[8];
+          while (remaining.load() > 0) {
+            std::size_t popped = ring.pop_batch(batch, c % 2 == 0 ? 8 : 1);
+            if (popped == 0) {
+              std::this_thread::yield();
+            }
+            for (std::size_t i = 0; i < popped; i++) {
+              int producer = batch[i] / per_producer;
+              auto slot = static_cast<std::size_t>(producer);
+              if (batch[i] <= last[slot]) {
+                ordered = false;
+              }
+              last[slot] = batch[i];
+              seen[static_cast<std::size_t>(batch[i])]++;
+            }
+            remaining -= static_cast<int>(popped);
+          }
+        });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(ring.empty());
+  for (const auto& count : seen) {
+    ASSERT_EQ(count.load(), 1);
+  }
+}
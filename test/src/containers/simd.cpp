@@ -0,0 +1,158 @@
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "containers/simd.hpp"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// Every instruction set this machine can run, scalar included
+std::vector<steev::simd::isa> available_isas()
+{
+  std::vector<steev::simd::isa> levels {steev::simd::isa::scalar};
+  if (steev::simd::detected_isa() >= steev::simd::isa::sse2) {
+    levels.push_back(steev::simd::isa::sse2);
+  }
+  if (steev::simd::detected_isa() >= steev::simd::isa::avx2) {
+    levels.push_back(steev::simd::isa::avx2);
+  }
+  return levels;
+}
+}  // namespace
+
+template<typename T>
+class SimdTest : public ::testing::Test
+{
+protected:
+  // Long enough to cover several AVX2 blocks plus a ragged tail
+  static constexpr std::size_t length = 100;
+
+  std::vector<T> ascending() const
+  {
+    std::vector<T> values(length);
+    for (std::size_t i = 0; i < length; i++) {
+      values[i] = static_cast<T>(i + 1);
+    }
+    return values;
+  }
+};
+
+using SimdTypes = ::testing::Types<std::int8_t,
+                                   std::uint16_t,
+                                   std::int32_t,
+                                   std::uint64_t,
+                                   float,
+                                   double>;
+TYPED_TEST_SUITE(SimdTest, SimdTypes);
+
+TYPED_TEST(SimdTest, MismatchAtEveryPosition)
+{
+  auto lhs = this->ascending();
+  for (auto level : available_isas()) {
+    for (std::size_t count = 0; count <= lhs.size(); count++) {
+      EXPECT_EQ(steev::simd::mismatch(lhs.data(), lhs.data(), count, level),
+                count);
+    }
+    for (std::size_t position = 0; position < lhs.size(); position++) {
+      auto rhs = lhs;
+      rhs[position] = TypeParam {0};
+      EXPECT_EQ(steev::simd::mismatch(
+                    lhs.data(), rhs.data(), lhs.size(), level),
+                position);
+      EXPECT_EQ(steev::simd::mismatch(lhs.data(), rhs.data(), position, level),
+                position);
+    }
+  }
+}
+
+TYPED_TEST(SimdTest, FindAndCount)
+{
+  auto values = this->ascending();
+  for (auto level : available_isas()) {
+    for (std::size_t position = 0; position < values.size(); position++) {
+      auto needle = values[position];
+      EXPECT_EQ(steev::simd::find(values.data(), values.size(), needle, level),
+                position);
+      EXPECT_EQ(steev::simd::find(values.data(), position, needle, level),
+                position);
+    }
+    EXPECT_EQ(steev::simd::find(
+                  values.data(), values.size(), TypeParam {0}, level),
+              values.size());
+
+    std::vector<TypeParam> repeated(77, TypeParam {3});
+    repeated[5] = TypeParam {4};
+    repeated[70] = TypeParam {4};
+    EXPECT_EQ(steev::simd::count(
+                  repeated.data(), repeated.size(), TypeParam {3}, level),
+              75);
+    EXPECT_EQ(steev::simd::count(
+                  repeated.data(), repeated.size(), TypeParam {4}, level),
+              2);
+  }
+}
+
+TYPED_TEST(SimdTest, FillLeavesNeighboursAlone)
+{
+  for (auto level : available_isas()) {
+    for (std::size_t count = 0; count < 70; count++) {
+      std::vector<TypeParam> values(72, TypeParam {1});
+      steev::simd::fill(values.data() + 1, count, TypeParam {9}, level);
+      EXPECT_EQ(values[0], TypeParam {1});
+      EXPECT_EQ(steev::simd::count(values.data(), values.size(), TypeParam {9}),
+                count);
+      EXPECT_EQ(values[count + 1], TypeParam {1});
+    }
+  }
+}
+
+// Floats compare by value, not by bits
+TEST(SimdFloatTest, NanAndSignedZero)
+{
+  constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> lhs(40, 1.0);
+  std::vector<double> rhs(40, 1.0);
+  lhs[33] = 0.0;
+  rhs[33] = -0.0;
+  for (auto level : available_isas()) {
+    EXPECT_EQ(steev::simd::mismatch(lhs.data(), rhs.data(), 40, level), 40);
+    EXPECT_EQ(steev::simd::find(lhs.data(), 40, -0.0, level), 33);
+  }
+
+  lhs[20] = nan;
+  rhs[20] = nan;
+  for (auto level : available_isas()) {
+    EXPECT_EQ(steev::simd::mismatch(lhs.data(), rhs.data(), 40, level), 20);
+    EXPECT_EQ(steev::simd::find(lhs.data(), 40, nan, level), 40);
+    EXPECT_EQ(steev::simd::count(lhs.data(), 40, nan, level), 0);
+  }
+}
+
+// Types the kernels don't cover still work through the scalar loops
+TEST(SimdFallbackTest, NonArithmetic)
+{
+  static_assert(!steev::simd::vectorizable<std::vector<int>>);
+  static_assert(!steev::simd::vectorizable<long double>);
+
+  std::vector<std::vector<int>> values {{1}, {2, 3}, {4}};
+  std::vector<int> needle {2, 3};
+  EXPECT_EQ(steev::simd::find(values.data(), values.size(), needle), 1);
+  EXPECT_EQ(steev::simd::count(values.data(), values.size(), needle), 1);
+}
+
+TEST(SimdConstexprTest, ScalarDuringConstantEvaluation)
+{
+  constexpr auto check = []
+  {
+    int lhs[] {1, 2, 3, 4};
+    int rhs[] {1, 2, 5, 4};
+    steev::simd::fill(rhs, 1, 7);
+    return steev::simd::mismatch(lhs, rhs, 4) == 0
+        && steev::simd::find(lhs, 4, 3) == 2
+        && steev::simd::count(rhs, 4, 7) == 1;
+  };
+  static_assert(check());
+}
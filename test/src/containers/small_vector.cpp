@@ -0,0 +1,177 @@
+#include <list>
+#include <stdexcept>
+#include <string>
+
+#include "containers/small_vector.hpp"
+
+#include <gtest/gtest.h>
+
+#include "memory/smart_ptr/unique_ptr.hpp"
+
+class SmallVectorTest : public ::testing::Test
+{
+protected:
+  steev::small_vector<int, 8> vec = {1, 2, 3, 4, 5};
+};
+
+TEST_F(SmallVectorTest, StartsInline)
+{
+  steev::small_vector<int, 8> empty;
+  EXPECT_TRUE(empty.is_inline());
+  EXPECT_EQ(empty.capacity(), 8);
+  EXPECT_TRUE(vec.is_inline());
+  EXPECT_EQ(vec.size(), 5);
+}
+
+TEST_F(SmallVectorTest, AccessElements)
+{
+  EXPECT_EQ(vec[0], 1);
+  EXPECT_EQ(vec.at(1), 2);
+  EXPECT_EQ(vec.front(), 1);
+  EXPECT_EQ(vec.back(), 5);
+  EXPECT_THROW(static_cast<void>(vec.at(5)), std::out_of_range);
+}
+
+TEST_F(SmallVectorTest, SpillsToHeap)
+{
+  for (int i = 6; i <= 8; i++) {
+    vec.push_back(int {i});
+  }
+  EXPECT_TRUE(vec.is_inline());
+  vec.push_back(9);
+  EXPECT_FALSE(vec.is_inline());
+  EXPECT_GE(vec.capacity(), 9);
+  for (int i = 0; i < 9; i++) {
+    EXPECT_EQ(vec[static_cast<std::size_t>(i)], i + 1);
+  }
+}
+
+TEST_F(SmallVectorTest, ShrinkBackInline)
+{
+  vec.resize(20);
+  EXPECT_FALSE(vec.is_inline());
+  vec.resize(3);
+  vec.shrink_to_fit();
+  EXPECT_TRUE(vec.is_inline());
+  EXPECT_EQ(vec, (steev::small_vector<int, 8> {1, 2, 3}));
+}
+
+TEST_F(SmallVectorTest, InsertAndErase)
+{
+  auto it = vec.insert(vec.begin() + 2, 10);
+  EXPECT_EQ(*it, 10);
+  EXPECT_EQ(vec.size(), 6);
+  it = vec.erase(vec.begin());
+  EXPECT_EQ(*it, 2);
+  EXPECT_EQ(vec, (steev::small_vector<int, 8> {2, 10, 3, 4, 5}));
+}
+
+TEST_F(SmallVectorTest, InsertRanges)
+{
+  int more[] = {6, 7, 8, 9};
+  vec.insert(vec.begin() + 1, more, more + 2);
+  vec.append_range(std::list<int> {8, 9});
+  EXPECT_FALSE(vec.is_inline());
+  EXPECT_EQ(vec, (steev::small_vector<int, 8> {1, 6, 7, 2, 3, 4, 5, 8, 9}));
+
+  vec.emplace(vec.begin(), 0);
+  EXPECT_EQ(vec.front(), 0);
+  EXPECT_EQ(vec.emplace_back(10), 10);
+}
+
+// Growing moves the elements, so the argument has to be read first
+TEST(SmallVectorAliasTest, PushBackOwnElement)
+{
+  steev::small_vector<std::string, 2> words = {"first", "second"};
+  words.push_back(std::move(words[0]));
+  words.push_back(words[1]);
+  words.insert(words.begin(), words[1]);
+  EXPECT_EQ(words.size(), 5);
+  EXPECT_EQ(words[0], "second");
+  EXPECT_EQ(words[3], "first");
+  EXPECT_EQ(words[4], "second");
+}
+
+TEST_F(SmallVectorTest, PopBack)
+{
+  vec.pop_back();
+  EXPECT_EQ(vec.back(), 4);
+  vec.clear();
+  EXPECT_TRUE(vec.empty());
+  EXPECT_THROW(vec.pop_back(), std::runtime_error);
+}
+
+TEST_F(SmallVectorTest, Iterate)
+{
+  int sum = 0;
+  for (const auto& val : vec) {
+    sum += val;
+  }
+  EXPECT_EQ(sum, 15);
+}
+
+TEST_F(SmallVectorTest, Assign)
+{
+  vec.assign(12, 7);
+  EXPECT_EQ(vec.size(), 12);
+  EXPECT_EQ(vec[11], 7);
+}
+
+TEST_F(SmallVectorTest, Compare)
+{
+  steev::small_vector<int, 8> other = {1, 2, 3, 4, 6};
+  EXPECT_LT(vec, other);
+  EXPECT_NE(vec, other);
+}
+
+TEST(SmallVectorMoveTest, MoveInline)
+{
+  steev::small_vector<std::string, 4> source = {"a", "b"};
+  steev::small_vector<std::string, 4> target = std::move(source);
+  EXPECT_TRUE(target.is_inline());
+  EXPECT_EQ(target.size(), 2);
+  EXPECT_EQ(target[1], "b");
+  EXPECT_TRUE(source.empty());
+}
+
+TEST(SmallVectorMoveTest, MoveHeapStealsBuffer)
+{
+  steev::small_vector<int, 2> source = {1, 2, 3, 4};
+  const int* buffer = source.data();
+  steev::small_vector<int, 2> target;
+  target = std::move(source);
+  EXPECT_EQ(target.data(), buffer);
+  EXPECT_TRUE(source.empty());
+  EXPECT_TRUE(source.is_inline());
+}
+
+TEST(SmallVectorMoveTest, Copy)
+{
+  steev::small_vector<std::string, 2> source = {"x", "y", "z"};
+  steev::small_vector<std::string, 2> copy = source;
+  EXPECT_EQ(copy.size(), 3);
+  EXPECT_EQ(copy[2], "z");
+  EXPECT_EQ(source[2], "z");
+}
+
+TEST(SmallVectorMoveTest, SwapMixedStorage)
+{
+  steev::small_vector<int, 2> small = {1};
+  steev::small_vector<int, 2> large = {1, 2, 3, 4};
+  small.swap(large);
+  EXPECT_EQ(small.size(), 4);
+  EXPECT_EQ(large.size(), 1);
+  EXPECT_EQ(small[3], 4);
+  EXPECT_EQ(large[0], 1);
+}
+
+TEST(SmallVectorMoveTest, MoveOnlyElements)
+{
+  steev::small_vector<steev::unique_ptr<int>, 2> owners;
+  for (int i = 0; i < 5; i++) {
+    owners.push_back(steev::unique_ptr<int>(new int(i)));
+  }
+  owners.erase(owners.begin());
+  EXPECT_EQ(*owners[0], 1);
+  EXPECT_EQ(*owners[3], 4);
+}
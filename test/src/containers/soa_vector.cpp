@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <version>
+
+#include "containers/soa_vector.hpp"
+
+#include <gtest/gtest.h>
+
+class SoaVectorTest : public ::testing::Test
+{
+protected:
+  steev::soa_vector<int, double, std::string> vec = {
+      {1, 1.5, "one"},
+      {2, 2.5, "two"},
+      {3, 3.5, "three"},
+  };
+};
+
+TEST_F(SoaVectorTest, AccessRecords)
+{
+  EXPECT_EQ(vec.size(), 3);
+  EXPECT_EQ(std::get<0>(vec[1]), 2);
+  EXPECT_EQ(std::get<2>(vec.at(2)), "three");
+  EXPECT_EQ(std::get<0>(vec.front()), 1);
+  EXPECT_EQ(std::get<2>(vec.back()), "three");
+  EXPECT_THROW(static_cast<void>(vec.at(3)), std::out_of_range);
+}
+
+TEST_F(SoaVectorTest, ReferencesWriteThrough)
+{
+  std::get<0>(vec[0]) = 10;
+  auto [id, weight, name] = vec[1];
+  name = "deux";
+  EXPECT_EQ(std::get<0>(vec[0]), 10);
+  EXPECT_EQ(std::get<2>(vec[1]), "deux");
+}
+
+TEST_F(SoaVectorTest, ColumnsAreContiguous)
+{
+  std::span<int> ids = vec.column<0>();
+  ASSERT_EQ(ids.size(), 3);
+  EXPECT_EQ(std::accumulate(ids.begin(), ids.end(), 0), 6);
+  EXPECT_EQ(&ids[1], &std::get<0>(vec[1]));
+
+  const auto& view = vec;
+  std::span<const double> weights = view.column<1>();
+  EXPECT_DOUBLE_EQ(weights[2], 3.5);
+}
+
+TEST_F(SoaVectorTest, ColumnsStayInSyncWhenGrowing)
+{
+  for (int i = 4; i <= 100; i++) {
+    vec.emplace_back(i, i + 0.5, std::to_string(i));
+  }
+  ASSERT_EQ(vec.size(), 100);
+  EXPECT_GE(vec.capacity(), 100);
+  for (std::size_t i = 3; i < vec.size(); i++) {
+    const auto& [id, weight, name] = vec[i];
+    EXPECT_DOUBLE_EQ(weight, id + 0.5);
+    EXPECT_EQ(name, std::to_string(id));
+  }
+}
+
+TEST_F(SoaVectorTest, PushBackTuple)
+{
+  std::tuple<int, double, std::string> record {4, 4.5, "four"};
+  vec.push_back(record);
+  vec.push_back({5, 5.5, "five"});
+  EXPECT_EQ(vec.size(), 5);
+  EXPECT_EQ(std::get<2>(vec[3]), "four");
+  EXPECT_EQ(std::get<2>(record), "four");
+  EXPECT_EQ(std::get<0>(vec[4]), 5);
+}
+
+// The argument points into the column that has to move when growing
+TEST_F(SoaVectorTest, EmplaceBackFromOwnElement)
+{
+  vec.shrink_to_fit();
+  ASSERT_EQ(vec.size(), vec.capacity());
+  vec.emplace_back(4, 4.5, std::get<2>(vec[0]));
+  EXPECT_EQ(std::get<2>(vec[3]), "one");
+}
+
+TEST_F(SoaVectorTest, EraseShiftsEveryColumn)
+{
+  auto next = vec.erase(vec.begin());
+  EXPECT_EQ(vec.size(), 2);
+  EXPECT_EQ(std::get<0>(*next), 2);
+  EXPECT_EQ(vec.column<0>()[1], 3);
+  EXPECT_DOUBLE_EQ(vec.column<1>()[1], 3.5);
+  EXPECT_EQ(vec.column<2>()[1], "three");
+
+  next = vec.erase(vec.begin() + 1);
+  EXPECT_EQ(next, vec.end());
+  EXPECT_EQ(vec.size(), 1);
+}
+
+TEST_F(SoaVectorTest, PopBackAndClear)
+{
+  vec.pop_back();
+  EXPECT_EQ(vec.size(), 2);
+  vec.clear();
+  EXPECT_TRUE(vec.empty());
+  EXPECT_THROW(vec.pop_back(), std::runtime_error);
+}
+
+TEST_F(SoaVectorTest, IteratorIsRandomAccess)
+{
+#ifdef __cpp_lib_ranges_zip
+  static_assert(std::random_access_iterator<decltype(vec)::iterator>);
+  static_assert(std::random_access_iterator<decltype(vec)::const_iterator>);
+#endif
+
+  auto it = vec.begin();
+  EXPECT_EQ(vec.end() - it, 3);
+  EXPECT_EQ(std::get<0>(it[2]), 3);
+  EXPECT_LT(it, it + 1);
+
+  int total = 0;
+  for (auto [id, weight, name] : vec) {
+    total += id;
+    weight = 0.0;
+  }
+  EXPECT_EQ(total, 6);
+  EXPECT_DOUBLE_EQ(vec.column<1>()[0], 0.0);
+
+  const auto& view = vec;
+  decltype(vec)::const_iterator first = vec.begin();
+  EXPECT_EQ(first, view.begin());
+}
+
+TEST_F(SoaVectorTest, CopyAndMove)
+{
+  auto copy = vec;
+  EXPECT_EQ(copy, vec);
+  std::get<2>(copy[0]) = "uno";
+  EXPECT_EQ(std::get<2>(vec[0]), "one");
+
+  auto moved = std::move(copy);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(std::get<2>(moved[0]), "uno");
+
+  copy = moved;
+  EXPECT_EQ(copy, moved);
+  vec = std::move(moved);
+  EXPECT_EQ(vec, copy);
+}
+
+TEST(SoaVector, MoveOnlyField)
+{
+  steev::soa_vector<int, std::unique_ptr<int>> vec;
+  for (int i = 0; i < 20; i++) {
+    vec.emplace_back(i, std::make_unique<int>(i));
+  }
+  EXPECT_EQ(*std::get<1>(vec[19]), 19);
+  vec.erase(vec.begin());
+  EXPECT_EQ(*vec.column<1>()[0], 1);
+}
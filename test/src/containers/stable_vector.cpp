@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "containers/stable_vector.hpp"
+
+#include <gtest/gtest.h>
+
+class StableVectorTest : public ::testing::Test
+{
+protected:
+  // Small chunks so a handful of elements spans several of them
+  steev::stable_vector<int, 4> vec = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+};
+
+TEST_F(StableVectorTest, AccessElements)
+{
+  EXPECT_EQ(vec.size(), 10);
+  EXPECT_EQ(vec.capacity(), 12);
+  EXPECT_EQ(vec[4], 5);
+  EXPECT_EQ(vec.at(9), 10);
+  EXPECT_EQ(vec.front(), 1);
+  EXPECT_EQ(vec.back(), 10);
+  EXPECT_THROW(static_cast<void>(vec.at(10)), std::out_of_range);
+}
+
+TEST_F(StableVectorTest, GrowingKeepsAddresses)
+{
+  int* first = &vec[0];
+  int* last = &vec.back();
+  for (int i = 11; i <= 1000; i++) {
+    vec.push_back(i);
+  }
+  EXPECT_EQ(first, &vec[0]);
+  EXPECT_EQ(last, &vec[9]);
+  EXPECT_EQ(*last, 10);
+  EXPECT_EQ(vec[999], 1000);
+}
+
+// Adding chunks reallocates the table of chunks, not what iterators use
+TEST_F(StableVectorTest, GrowingKeepsIterators)
+{
+  auto second = vec.begin() + 1;
+  for (int i = 11; i <= 1000; i++) {
+    vec.push_back(i);
+  }
+  EXPECT_EQ(*second, 2);
+  EXPECT_EQ(second[998], 1000);
+}
+
+// The argument stays valid while a new chunk is added
+TEST_F(StableVectorTest, EmplaceBackFromOwnElement)
+{
+  vec.emplace_back(vec[0]);
+  vec.emplace_back(vec[1]);
+  vec.emplace_back(vec.back());
+  EXPECT_EQ(vec.size(), 13);
+  EXPECT_EQ(vec[12], 2);
+}
+
+TEST_F(StableVectorTest, IteratorIsRandomAccess)
+{
+  using Vector = decltype(vec);
+  static_assert(std::random_access_iterator<Vector::iterator>);
+  static_assert(std::random_access_iterator<Vector::const_iterator>);
+
+  EXPECT_EQ(vec.end() - vec.begin(), 10);
+  EXPECT_EQ(vec.begin()[5], 6);
+  EXPECT_EQ(*(vec.end() - 1), 10);
+
+  std::reverse(vec.begin(), vec.end());
+  EXPECT_EQ(vec.front(), 10);
+  EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end(), std::greater<>()));
+
+  const auto& view = vec;
+  Vector::const_iterator it = vec.begin();
+  EXPECT_EQ(it, view.begin());
+  EXPECT_EQ(std::count_if(view.begin(), view.end(), [](int x)
+                          { return x % 2 == 0; }),
+            5);
+}
+
+TEST_F(StableVectorTest, EraseShiftsLaterElements)
+{
+  int* before = &vec[1];
+  auto next = vec.erase(vec.begin() + 2);
+  EXPECT_EQ(*next, 4);
+  EXPECT_EQ(vec.size(), 9);
+  EXPECT_EQ(before, &vec[1]);
+  EXPECT_EQ(vec.back(), 10);
+
+  next = vec.erase(vec.end() - 1);
+  EXPECT_EQ(next, vec.end());
+}
+
+TEST_F(StableVectorTest, ClearKeepsChunks)
+{
+  vec.pop_back();
+  EXPECT_EQ(vec.size(), 9);
+  vec.clear();
+  EXPECT_TRUE(vec.empty());
+  EXPECT_EQ(vec.capacity(), 12);
+  EXPECT_THROW(vec.pop_back(), std::runtime_error);
+
+  vec.push_back(1);
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.capacity(), 4);
+  vec.pop_back();
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.capacity(), 0);
+}
+
+TEST_F(StableVectorTest, CopyAndMove)
+{
+  auto copy = vec;
+  EXPECT_EQ(copy, vec);
+  copy[0] = 100;
+  EXPECT_EQ(vec[0], 1);
+
+  int* element = &copy[0];
+  auto moved = std::move(copy);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(element, &moved[0]);
+
+  copy = moved;
+  EXPECT_EQ(copy, moved);
+  vec = std::move(moved);
+  EXPECT_EQ(vec, copy);
+}
+
+TEST(StableVector, DefaultChunkSize)
+{
+  EXPECT_EQ(steev::stable_vector<char>::chunk_size, 4096);
+  EXPECT_EQ(steev::stable_vector<double>::chunk_size, 512);
+  EXPECT_EQ((steev::stable_vector<char[3000]>::chunk_size), 16);
+}
+
+TEST(StableVector, NonTrivialElements)
+{
+  steev::stable_vector<std::string, 2> strings;
+  for (int i = 0; i < 9; i++) {
+    strings.push_back(std::string(32, static_cast<char>('a' + i)));
+  }
+  strings.erase(strings.begin());
+  EXPECT_EQ(strings.front(), std::string(32, 'b'));
+  EXPECT_EQ(strings.back(), std::string(32, 'i'));
+
+  steev::stable_vector<std::unique_ptr<int>, 2> pointers;
+  pointers.emplace_back(std::make_unique<int>(1));
+  pointers.emplace_back(std::make_unique<int>(2));
+  pointers.emplace_back(std::make_unique<int>(3));
+  pointers.erase(pointers.begin());
+  EXPECT_EQ(*pointers[1], 3);
+}
@@ -1,9 +1,26 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <ranges>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "containers/vector.hpp"
 
 #include <gtest/gtest.h>
 
+#include "memory/smart_ptr/shared_ptr.hpp"
+#include "memory/smart_ptr/unique_ptr.hpp"
+
+#if defined(__GLIBC__)
+#  include <malloc.h>
+#endif
+
 class VectorTest : public ::testing::Test
 {
 protected:
@@ -45,6 +62,39 @@ TEST_F(VectorTest, ResizeSmaller)
   vec.resize(3);
   EXPECT_EQ(vec.size(), 3);
 }
+
+// The bytes past the old size survive, since nothing writes to them
+TEST(VectorOverwriteTest, ResizeForOverwriteKeepsBuffer)
+{
+  steev::vector<unsigned char> buffer {1, 2, 3, 4};
+  buffer.resize_for_overwrite(2);
+  EXPECT_EQ(buffer.size(), 2);
+  buffer.resize_for_overwrite(4);
+  EXPECT_EQ(buffer.size(), 4);
+  EXPECT_EQ(buffer[3], 4);
+}
+
+TEST(VectorOverwriteTest, ReadTarget)
+{
+  const char message[] = "payload";
+  steev::vector<char> buffer(sizeof(message), steev::for_overwrite);
+  EXPECT_EQ(buffer.size(), sizeof(message));
+  std::memcpy(buffer.data(), message, sizeof(message));
+  EXPECT_STREQ(buffer.data(), message);
+}
+
+// Types with real constructors still get them run
+TEST(VectorOverwriteTest, NonTrivialElements)
+{
+  steev::vector<std::string> strings {"a"};
+  strings.resize_for_overwrite(3);
+  EXPECT_EQ(strings.size(), 3);
+  EXPECT_EQ(strings[0], "a");
+  EXPECT_TRUE(strings[2].empty());
+
+  steev::vector<std::string> sized(2, steev::for_overwrite);
+  EXPECT_TRUE(sized[1].empty());
+}
 // Element Access Tests
 TEST_F(VectorTest, AccessElements)
 {
@@ -158,6 +208,48 @@ TEST_F(VectorTest, LessThan)
   EXPECT_LT(vec, otherVec);
 }
 
+// Long vectors go through the vector kernels; the difference sits past the
+// first few blocks
+TEST(VectorCompareTest, LongVectors)
+{
+  steev::vector<std::int64_t> lhs(1000, 7);
+  steev::vector<std::int64_t> rhs(1000, 7);
+  EXPECT_EQ(lhs, rhs);
+
+  rhs[997] = 8;
+  EXPECT_NE(lhs, rhs);
+  EXPECT_LT(lhs, rhs);
+  rhs[997] = -8;
+  EXPECT_GT(lhs, rhs);
+}
+
+TEST(VectorCompareTest, Floats)
+{
+  steev::vector<float> lhs(100, 0.0F);
+  steev::vector<float> rhs(100, -0.0F);
+  EXPECT_EQ(lhs, rhs);
+  rhs[50] = std::numeric_limits<float>::quiet_NaN();
+  EXPECT_NE(rhs, rhs);
+}
+
+TEST_F(VectorTest, FindAndCount)
+{
+  EXPECT_EQ(find(vec, 4), vec.begin() + 3);
+  EXPECT_EQ(find(vec, 42), vec.end());
+  EXPECT_EQ(count(vec, 5), 1);
+
+  steev::vector<std::string> strings {"a", "b", "a"};
+  EXPECT_EQ(find(strings, "b"), strings.begin() + 1);
+  EXPECT_EQ(count(strings, "a"), 2);
+}
+
+TEST_F(VectorTest, AssignFromOwnElement)
+{
+  vec.assign(500, vec[2]);
+  EXPECT_EQ(vec.size(), 500);
+  EXPECT_EQ(count(vec, 3), 500);
+}
+
 // Swap Test
 TEST_F(VectorTest, Swap)
 {
@@ -183,3 +275,472 @@ TEST(VectorMoveTest, MoveAssignment)
   EXPECT_EQ(target, (std::vector<int> {1, 2, 3}));
   EXPECT_TRUE(source.empty());
 }
+
+// Allocator Tests
+struct AllocationStats
+{
+  int allocations = 0;
+  int deallocations = 0;
+  std::size_t live_elements = 0;
+};
+
+template<typename T>
+struct CountingAllocator
+{
+  using value_type = T;
+
+  AllocationStats* stats;
+
+  explicit CountingAllocator(AllocationStats* s)
+      : stats(s)
+  {
+  }
+
+  template<typename U>
+  CountingAllocator(const CountingAllocator<U>& other)
+      : stats(other.stats)
+  {
+  }
+
+  T* allocate(std::size_t count)
+  {
+    stats->allocations++;
+    stats->live_elements += count;
+    return static_cast<T*>(::operator new(count * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t count)
+  {
+    stats->deallocations++;
+    stats->live_elements -= count;
+    ::operator delete(ptr);
+  }
+
+  bool operator==(const CountingAllocator& other) const
+  {
+    return stats == other.stats;
+  }
+};
+
+TEST(VectorAllocatorTest, RoutesThroughAllocator)
+{
+  AllocationStats stats;
+  {
+    steev::vector<int, CountingAllocator<int>> counted(
+        {1, 2, 3}, CountingAllocator<int>(&stats));
+    EXPECT_EQ(stats.allocations, 1);
+    for (int i = 0; i < 10; i++) {
+      counted.push_back(int {i});
+    }
+    EXPECT_GT(stats.allocations, 1);
+    EXPECT_EQ(counted.size(), 13);
+    EXPECT_EQ(counted[12], 9);
+    EXPECT_EQ(stats.live_elements, counted.capacity());
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_elements, 0);
+}
+
+TEST(VectorAllocatorTest, CopyUsesAllocator)
+{
+  AllocationStats stats;
+  {
+    steev::vector<int, CountingAllocator<int>> counted(
+        {1, 2, 3}, CountingAllocator<int>(&stats));
+    auto copy = counted;
+    EXPECT_EQ(stats.allocations, 2);
+    EXPECT_EQ(copy, counted);
+    EXPECT_EQ(copy.get_allocator(), counted.get_allocator());
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+}
+
+TEST(VectorAllocatorTest, MoveAssignmentAcrossAllocators)
+{
+  AllocationStats first;
+  AllocationStats second;
+  steev::vector<int, CountingAllocator<int>> source(
+      {1, 2, 3}, CountingAllocator<int>(&first));
+  steev::vector<int, CountingAllocator<int>> target {
+      CountingAllocator<int>(&second)};
+  target = std::move(source);
+  EXPECT_EQ(target, (steev::vector<int, CountingAllocator<int>>(
+                        {1, 2, 3}, CountingAllocator<int>(&second))));
+  EXPECT_TRUE(source.empty());
+  EXPECT_EQ(target.get_allocator().stats, &second);
+}
+
+TEST(VectorAllocatorTest, NonTrivialElements)
+{
+  steev::vector<std::string> strings;
+  for (int i = 0; i < 20; i++) {
+    strings.push_back(std::string(32, static_cast<char>('a' + i)));
+  }
+  strings.insert(strings.begin(), std::string("front"));
+  strings.erase(strings.begin() + 1);
+  EXPECT_EQ(strings.size(), 20);
+  EXPECT_EQ(strings.front(), "front");
+  EXPECT_EQ(strings.back(), std::string(32, 't'));
+
+  steev::vector<std::string> copy = strings;
+  EXPECT_EQ(copy[5], strings[5]);
+}
+
+// Relocation Tests
+struct MoveCounted
+{
+  static inline int moves = 0;
+  int value;
+
+  MoveCounted(int v)
+      : value(v)
+  {
+  }
+  MoveCounted(MoveCounted&& other) noexcept
+      : value(other.value)
+  {
+    moves++;
+  }
+  MoveCounted& operator=(MoveCounted&& other) noexcept
+  {
+    value = other.value;
+    moves++;
+    return *this;
+  }
+  ~MoveCounted() {}
+};
+
+struct RelocatableMoveCounted : MoveCounted
+{
+  using MoveCounted::MoveCounted;
+};
+
+template<>
+struct steev::is_trivially_relocatable<RelocatableMoveCounted>
+    : std::true_type
+{
+};
+
+TEST(VectorRelocationTest, GrowthRelocatesBitwise)
+{
+  steev::vector<RelocatableMoveCounted> values;
+  for (int i = 0; i < 100; i++) {
+    values.push_back(RelocatableMoveCounted {i});
+  }
+  MoveCounted::moves = 0;
+  values.reserve(1000);
+  values.insert(values.begin() + 10, RelocatableMoveCounted {-1});
+  values.erase(values.begin() + 20);
+  EXPECT_EQ(MoveCounted::moves, 1);
+  EXPECT_EQ(values.size(), 100);
+  EXPECT_EQ(values[10].value, -1);
+  EXPECT_EQ(values[11].value, 10);
+  EXPECT_EQ(values[20].value, 20);
+  EXPECT_EQ(values[99].value, 99);
+}
+
+TEST(VectorRelocationTest, GrowthMovesOtherwise)
+{
+  steev::vector<MoveCounted> values;
+  for (int i = 0; i < 100; i++) {
+    values.push_back(MoveCounted {i});
+  }
+  MoveCounted::moves = 0;
+  values.reserve(1000);
+  EXPECT_EQ(MoveCounted::moves, 100);
+  EXPECT_EQ(values[99].value, 99);
+}
+
+TEST(VectorRelocationTest, SmartPointers)
+{
+  steev::vector<steev::unique_ptr<int>> owners;
+  for (int i = 0; i < 50; i++) {
+    owners.push_back(steev::unique_ptr<int>(new int(i)));
+  }
+  owners.insert(owners.begin(), steev::unique_ptr<int>(new int(-1)));
+  owners.erase(owners.begin() + 1);
+  EXPECT_EQ(owners.size(), 50);
+  EXPECT_EQ(*owners[0], -1);
+  EXPECT_EQ(*owners[1], 1);
+  EXPECT_EQ(*owners[49], 49);
+
+  steev::vector<steev::shared_ptr<int>> shared;
+  auto first = steev::make_shared<int>(7);
+  for (int i = 0; i < 50; i++) {
+    shared.push_back(steev::shared_ptr<int>(first));
+  }
+  EXPECT_EQ(first.use_count(), 51);
+  shared.erase(shared.begin());
+  EXPECT_EQ(first.use_count(), 50);
+  shared.clear();
+  EXPECT_EQ(first.use_count(), 1);
+}
+
+// Growth Policy Tests
+TEST(VectorGrowthTest, DefaultConstructorDoesNotAllocate)
+{
+  AllocationStats stats;
+  steev::vector<int, CountingAllocator<int>> counted {
+      CountingAllocator<int>(&stats)};
+  EXPECT_EQ(counted.capacity(), 0);
+  EXPECT_EQ(stats.allocations, 0);
+
+  counted.push_back(1);
+  EXPECT_EQ(stats.allocations, 1);
+}
+
+template<typename GrowthPolicy>
+std::vector<std::size_t> capacities_after_pushes(int count)
+{
+  steev::vector<int, steev::allocator<int>, GrowthPolicy> grown;
+  std::vector<std::size_t> capacities;
+  for (int i = 0; i < count; i++) {
+    grown.push_back(int {i});
+    if (capacities.empty() || capacities.back() != grown.capacity()) {
+      capacities.push_back(grown.capacity());
+    }
+  }
+  return capacities;
+}
+
+TEST(VectorGrowthTest, Doubling)
+{
+  EXPECT_EQ(capacities_after_pushes<steev::doubling_growth>(20),
+            (std::vector<std::size_t> {1, 2, 4, 8, 16, 32}));
+}
+
+TEST(VectorGrowthTest, OneAndHalf)
+{
+  EXPECT_EQ(capacities_after_pushes<steev::one_and_half_growth>(20),
+            (std::vector<std::size_t> {1, 2, 3, 4, 6, 9, 13, 19, 28}));
+}
+
+TEST(VectorGrowthTest, InsertGrowsLikePushBack)
+{
+  steev::vector<int, steev::allocator<int>, steev::one_and_half_growth> grown;
+  for (int i = 0; i < 10; i++) {
+    grown.insert(grown.begin(), int {i});
+  }
+  EXPECT_EQ(grown.capacity(), 13);
+  EXPECT_EQ(grown.front(), 9);
+  EXPECT_EQ(grown.back(), 0);
+}
+
+TEST(VectorGrowthTest, SizeClassRoundingKeepsSlack)
+{
+  steev::vector<char, steev::allocator<char>, steev::size_class_growth<>>
+      rounded;
+  rounded.push_back('a');
+  EXPECT_GE(rounded.capacity(), 1);
+  std::size_t first_capacity = rounded.capacity();
+  for (std::size_t i = 1; i < first_capacity; i++) {
+    rounded.push_back('b');
+  }
+  EXPECT_EQ(rounded.capacity(), first_capacity);
+
+  rounded.reserve(100);
+  EXPECT_GE(rounded.capacity(), 100);
+  rounded.shrink_to_fit();
+  EXPECT_GE(rounded.capacity(), rounded.size());
+}
+
+#if defined(__GLIBC__)
+// Growing an existing buffer goes through realloc, which has to keep the
+// slack too
+TEST(VectorGrowthTest, SizeClassRoundingAfterRealloc)
+{
+  steev::vector<char, steev::allocator<char>, steev::size_class_growth<>>
+      rounded;
+  rounded.push_back('a');
+  EXPECT_EQ(rounded.capacity(), malloc_usable_size(rounded.data()));
+  for (int growths = 0; growths < 2; growths++) {
+    std::size_t capacity = rounded.capacity();
+    while (rounded.capacity() == capacity) {
+      rounded.push_back('b');
+    }
+    EXPECT_EQ(rounded.capacity(), malloc_usable_size(rounded.data()));
+  }
+}
+#endif
+
+TEST(VectorGrowthTest, ReserveNeverShrinks)
+{
+  steev::vector<int> grown;
+  grown.reserve(50);
+  grown.reserve(10);
+  EXPECT_EQ(grown.capacity(), 50);
+}
+
+// Emplace and Range Tests
+TEST(VectorEmplaceTest, EmplaceBackConstructsInPlace)
+{
+  steev::vector<std::pair<int, std::string>> pairs;
+  auto& first = pairs.emplace_back(1, "one");
+  EXPECT_EQ(first.second, "one");
+  pairs.emplace_back(2, std::string(3, 'x'));
+  EXPECT_EQ(pairs.size(), 2);
+  EXPECT_EQ(pairs.back().second, "xxx");
+}
+
+TEST(VectorEmplaceTest, EmplaceBackFromOwnElement)
+{
+  steev::vector<std::string> strings;
+  strings.push_back(std::string(40, 'a'));
+  for (int i = 0; i < 10; i++) {
+    strings.emplace_back(strings.front());
+  }
+  EXPECT_EQ(strings.size(), 11);
+  EXPECT_EQ(strings.back(), std::string(40, 'a'));
+
+  const std::string copied(40, 'c');
+  strings.push_back(copied);
+  EXPECT_EQ(strings.back(), copied);
+}
+
+TEST(VectorEmplaceTest, EmplaceInMiddle)
+{
+  steev::vector<std::string> strings {"a", "c"};
+  auto it = strings.emplace(strings.begin() + 1, std::size_t {1}, 'b');
+  EXPECT_EQ(*it, "b");
+  strings.emplace(strings.end(), "d");
+  EXPECT_EQ(strings, (steev::vector<std::string> {"a", "b", "c", "d"}));
+
+  const std::string front = "front";
+  strings.insert(strings.begin(), front);
+  EXPECT_EQ(strings.front(), "front");
+}
+
+namespace
+{
+// Counts live objects; move assignment throws once armed
+struct AssignThrows
+{
+  static inline int alive = 0;
+  static inline bool armed = false;
+  int value = 0;
+
+  explicit AssignThrows(int v)
+      : value(v)
+  {
+    alive++;
+  }
+
+  AssignThrows(const AssignThrows& other)
+      : value(other.value)
+  {
+    alive++;
+  }
+
+  AssignThrows(AssignThrows&& other) noexcept
+      : value(other.value)
+  {
+    alive++;
+  }
+
+  AssignThrows& operator=(const AssignThrows& other) = default;
+
+  AssignThrows& operator=(AssignThrows&& other)
+  {
+    if (armed) {
+      throw std::runtime_error("assignment");
+    }
+    value = other.value;
+    return *this;
+  }
+
+  ~AssignThrows() { alive--; }
+};
+}  // namespace
+
+// A throwing shift leaves every constructed element owned by the vector
+TEST(VectorEmplaceTest, InsertInMiddleThrowingAssignment)
+{
+  {
+    steev::vector<AssignThrows> elements;
+    elements.reserve(4);
+    elements.emplace_back(1);
+    elements.emplace_back(2);
+    elements.emplace_back(3);
+
+    AssignThrows::armed = true;
+    EXPECT_THROW(elements.insert(elements.begin(), AssignThrows {0}),
+                 std::runtime_error);
+    AssignThrows::armed = false;
+    EXPECT_EQ(elements.size(), 4);
+    EXPECT_EQ(AssignThrows::alive, 4);
+  }
+  EXPECT_EQ(AssignThrows::alive, 0);
+}
+
+TEST(VectorRangeTest, InsertIteratorPair)
+{
+  steev::vector<int> numbers {1, 5};
+  std::vector<int> middle {2, 3, 4};
+  auto it = numbers.insert(numbers.begin() + 1, middle.begin(), middle.end());
+  EXPECT_EQ(*it, 2);
+  EXPECT_EQ(numbers, (steev::vector<int> {1, 2, 3, 4, 5}));
+}
+
+TEST(VectorRangeTest, AppendRangeReservesOnce)
+{
+  AllocationStats stats;
+  steev::vector<int, CountingAllocator<int>> counted {
+      CountingAllocator<int>(&stats)};
+  std::vector<int> batch(1000, 7);
+  counted.append_range(batch);
+  EXPECT_EQ(stats.allocations, 1);
+  EXPECT_EQ(counted.size(), 1000);
+  EXPECT_EQ(counted[999], 7);
+}
+
+TEST(VectorRangeTest, InsertRangeNonTrivial)
+{
+  steev::vector<std::string> strings {"a", "e"};
+  std::vector<std::string> middle {"b", "c", "d"};
+  strings.insert_range(strings.begin() + 1, middle);
+  EXPECT_EQ(strings,
+            (steev::vector<std::string> {"a", "b", "c", "d", "e"}));
+
+  std::list<std::string> tail {"f", "g"};
+  strings.append_range(tail);
+  EXPECT_EQ(strings.size(), 7);
+  EXPECT_EQ(strings.back(), "g");
+}
+
+TEST(VectorRangeTest, InputRange)
+{
+  std::istringstream input("3 4 5");
+  steev::vector<int> numbers {1, 2, 6};
+  numbers.insert_range(numbers.begin() + 2,
+                       std::ranges::istream_view<int>(input));
+  EXPECT_EQ(numbers, (steev::vector<int> {1, 2, 3, 4, 5, 6}));
+}
+
+// Counting an istream_view gives a sized range of move-only iterators
+TEST(VectorRangeTest, SizedMoveOnlyInputRange)
+{
+  std::istringstream input("3 4 5 7");
+  auto view = std::ranges::istream_view<int>(input);
+  auto counted = std::views::counted(view.begin(), 3);
+  static_assert(std::ranges::sized_range<decltype(counted)>);
+  static_assert(!std::copyable<std::ranges::iterator_t<decltype(counted)>>);
+
+  steev::vector<int> numbers {1, 2, 6};
+  numbers.insert_range(numbers.begin() + 2, counted);
+  EXPECT_EQ(numbers, (steev::vector<int> {1, 2, 3, 4, 5, 6}));
+}
+
+TEST(VectorRangeTest, ViewsAndSteevRanges)
+{
+  steev::vector<int> source {1, 2, 3, 4};
+  static_assert(std::ranges::contiguous_range<steev::vector<int>>);
+
+  steev::vector<int> doubled;
+  doubled.append_range(
+      source | std::views::transform([](int value) { return value * 2; }));
+  EXPECT_EQ(doubled, (steev::vector<int> {2, 4, 6, 8}));
+
+  doubled.append_range(source);
+  EXPECT_EQ(doubled.size(), 8);
+  EXPECT_EQ(doubled.back(), 4);
+}
@@ -0,0 +1,108 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "memory/aligned_allocator.hpp"
+
+#include <gtest/gtest.h>
+
+#include "containers/growth_policy.hpp"
+#include "containers/vector.hpp"
+#include "memory/smart_ptr/unique_ptr.hpp"
+
+namespace
+{
+bool aligned_to(const void* ptr, std::size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+}  // namespace
+
+TEST(AlignedAllocatorTest, SmallBlocksAreCacheLineAligned)
+{
+  steev::aligned_allocator<char> alloc;
+  const std::size_t counts[] {1, 3, 100, 4096};
+  for (std::size_t count : counts) {
+    char* ptr = alloc.allocate(count);
+    EXPECT_TRUE(aligned_to(ptr, steev::cache_line_size));
+    std::memset(ptr, 1, count);
+    alloc.deallocate(ptr, count);
+  }
+
+  steev::aligned_allocator<float, 256> wide;
+  float* ptr = wide.allocate(10);
+  EXPECT_TRUE(aligned_to(ptr, 256));
+  wide.deallocate(ptr, 10);
+}
+
+// Blocks past the threshold are mapped on huge page boundaries and report
+// the rest of their last page
+TEST(AlignedAllocatorTest, LargeBlocksAreHugePageAligned)
+{
+  steev::aligned_allocator<std::uint64_t> alloc;
+  std::size_t count = steev::huge_page_size / sizeof(std::uint64_t) + 1;
+  auto [ptr, capacity] =
+      steev::allocator_traits<decltype(alloc)>::allocate_at_least(alloc,
+                                                                   count);
+  EXPECT_TRUE(aligned_to(ptr, steev::huge_page_size));
+  EXPECT_EQ(capacity * sizeof(std::uint64_t), 2 * steev::huge_page_size);
+  std::memset(ptr, 0xFF, capacity * sizeof(std::uint64_t));
+  alloc.deallocate(ptr, capacity);
+}
+
+TEST(AlignedAllocatorTest, ZeroThresholdNeverMaps)
+{
+  steev::aligned_allocator<char, 64, 0> alloc;
+  auto [ptr, capacity] =
+      steev::allocator_traits<decltype(alloc)>::allocate_at_least(
+          alloc, steev::huge_page_size * 2);
+  EXPECT_TRUE(aligned_to(ptr, 64));
+  EXPECT_EQ(capacity, steev::huge_page_size * 2);
+  alloc.deallocate(ptr, capacity);
+}
+
+TEST(AlignedAllocatorTest, Rebind)
+{
+  using rebound = steev::allocator_traits<
+      steev::aligned_allocator<int, 128>>::rebind_alloc<char>;
+  static_assert(std::is_same_v<
+                rebound,
+                steev::aligned_allocator<char, 128, steev::huge_page_size>>);
+  EXPECT_EQ(steev::aligned_allocator<int>(), steev::aligned_allocator<int>());
+}
+
+TEST(AlignedAllocatorTest, Vector)
+{
+  steev::vector<float,
+                steev::aligned_allocator<float>,
+                steev::size_class_growth<>>
+      values;
+  for (int i = 0; i < 1 << 20; i++) {
+    values.push_back(static_cast<float>(i));
+    ASSERT_TRUE(aligned_to(values.data(), steev::cache_line_size));
+  }
+  EXPECT_TRUE(aligned_to(values.data(), steev::huge_page_size));
+  EXPECT_EQ(values.capacity() * sizeof(float) % steev::huge_page_size, 0);
+  EXPECT_EQ(values[12345], 12345.0F);
+}
+
+TEST(AlignedAllocatorTest, AllocateUnique)
+{
+  auto table = steev::allocate_unique<double[]>(
+      steev::aligned_allocator<double>(), 1000);
+  EXPECT_TRUE(aligned_to(table.get(), steev::cache_line_size));
+  EXPECT_EQ(table.get_deleter().size(), 1000);
+  EXPECT_EQ(table[999], 0.0);
+
+  auto strings = steev::allocate_unique<std::string[]>(
+      steev::aligned_allocator<char>(), 3);
+  strings[2] = std::string(100, 'x');
+  EXPECT_TRUE(strings[0].empty());
+
+  // The old table goes back to the allocator it came from
+  table = steev::allocate_unique<double[]>(
+      steev::aligned_allocator<double>(), steev::huge_page_size);
+  EXPECT_TRUE(aligned_to(table.get(), steev::huge_page_size));
+}
@@ -0,0 +1,173 @@
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "memory/allocator_traits.hpp"
+
+#include <gtest/gtest.h>
+
+#include "memory/allocator.hpp"
+
+// Minimal allocator exercising the defaults of allocator_traits
+template<typename T>
+struct MinimalAllocator
+{
+  using value_type = T;
+
+  MinimalAllocator() = default;
+
+  template<typename U>
+  MinimalAllocator(const MinimalAllocator<U>&)
+  {
+  }
+
+  T* allocate(std::size_t count)
+  {
+    return static_cast<T*>(::operator new(count * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t) { ::operator delete(ptr); }
+
+  bool operator==(const MinimalAllocator&) const { return true; }
+};
+
+// Stateful allocator overriding construct and the propagation traits
+template<typename T>
+struct TrackingAllocator
+{
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using is_always_equal = std::false_type;
+
+  int* constructs;
+
+  explicit TrackingAllocator(int* counter)
+      : constructs(counter)
+  {
+  }
+
+  T* allocate(std::size_t count)
+  {
+    return static_cast<T*>(::operator new(count * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t) { ::operator delete(ptr); }
+
+  template<typename U, typename... Args>
+  void construct(U* ptr, Args&&... args)
+  {
+    ++*constructs;
+    ::new (static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+  }
+
+  bool operator==(const TrackingAllocator& other) const
+  {
+    return constructs == other.constructs;
+  }
+};
+
+TEST(AllocatorTraitsTest, DefaultTypes)
+{
+  using traits = steev::allocator_traits<MinimalAllocator<int>>;
+  static_assert(std::is_same_v<traits::pointer, int*>);
+  static_assert(std::is_same_v<traits::const_pointer, const int*>);
+  static_assert(std::is_same_v<traits::size_type, std::size_t>);
+  static_assert(std::is_same_v<traits::difference_type, std::ptrdiff_t>);
+  static_assert(traits::is_always_equal::value);
+  static_assert(!traits::propagate_on_container_copy_assignment::value);
+  static_assert(!traits::propagate_on_container_move_assignment::value);
+  static_assert(!traits::propagate_on_container_swap::value);
+}
+
+TEST(AllocatorTraitsTest, DeclaredTraits)
+{
+  using traits = steev::allocator_traits<TrackingAllocator<int>>;
+  static_assert(!traits::is_always_equal::value);
+  static_assert(traits::propagate_on_container_copy_assignment::value);
+}
+
+TEST(AllocatorTraitsTest, Rebind)
+{
+  using traits = steev::allocator_traits<MinimalAllocator<int>>;
+  static_assert(std::is_same_v<traits::rebind_alloc<double>,
+                               MinimalAllocator<double>>);
+  static_assert(std::is_same_v<traits::rebind_traits<double>::pointer,
+                               double*>);
+}
+
+TEST(AllocatorTraitsTest, AllocateConstructDestroy)
+{
+  MinimalAllocator<int> alloc;
+  using traits = steev::allocator_traits<MinimalAllocator<int>>;
+
+  int* ptr = traits::allocate(alloc, 2);
+  traits::construct(alloc, ptr, 7);
+  traits::construct(alloc, ptr + 1, 8);
+  EXPECT_EQ(ptr[0], 7);
+  EXPECT_EQ(ptr[1], 8);
+  traits::destroy(alloc, ptr);
+  traits::destroy(alloc, ptr + 1);
+  traits::deallocate(alloc, ptr, 2);
+}
+
+TEST(AllocatorTraitsTest, CustomConstruct)
+{
+  int constructs = 0;
+  TrackingAllocator<int> alloc(&constructs);
+  using traits = steev::allocator_traits<TrackingAllocator<int>>;
+
+  int* ptr = traits::allocate(alloc, 1);
+  traits::construct(alloc, ptr, 3);
+  EXPECT_EQ(*ptr, 3);
+  EXPECT_EQ(constructs, 1);
+  traits::destroy(alloc, ptr);
+  traits::deallocate(alloc, ptr, 1);
+}
+
+TEST(AllocatorTraitsTest, MaxSize)
+{
+  MinimalAllocator<int> alloc;
+  EXPECT_EQ(steev::allocator_traits<MinimalAllocator<int>>::max_size(alloc),
+            SIZE_MAX / sizeof(int));
+}
+
+TEST(AllocatorTest, AllocateAndDeallocate)
+{
+  steev::allocator<int> alloc;
+  int* ptr = alloc.allocate(4);
+  ASSERT_NE(ptr, nullptr);
+  for (int i = 0; i < 4; i++) {
+    ptr[i] = i;
+  }
+  EXPECT_EQ(ptr[3], 3);
+  alloc.deallocate(ptr, 4);
+}
+
+TEST(AllocatorTest, OverAligned)
+{
+  struct alignas(64) Wide
+  {
+    char bytes[64];
+  };
+
+  steev::allocator<Wide> alloc;
+  Wide* ptr = alloc.allocate(3);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64, 0);
+  alloc.deallocate(ptr, 3);
+}
+
+TEST(AllocatorTest, TooLarge)
+{
+  steev::allocator<int> alloc;
+  EXPECT_THROW(static_cast<void>(alloc.allocate(SIZE_MAX)),
+               std::bad_array_new_length);
+}
+
+TEST(AllocatorTest, Equality)
+{
+  steev::allocator<int> a;
+  steev::allocator<double> b;
+  EXPECT_TRUE(a == b);
+}
@@ -0,0 +1,155 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "memory/smart_ptr/atomic_shared_ptr.hpp"
+
+#include <gtest/gtest.h>
+
+#include "memory/smart_ptr/shared_ptr.hpp"
+
+namespace
+{
+struct Counted
+{
+  static inline std::atomic<int> alive {0};
+
+  int value;
+
+  explicit Counted(int v)
+      : value(v)
+  {
+    alive++;
+  }
+
+  ~Counted() { alive--; }
+};
+}  // namespace
+
+// Test the empty state
+TEST(AtomicSharedPtrTest, DefaultIsEmpty)
+{
+  steev::atomic<steev::shared_ptr<int>> atomic;
+  EXPECT_EQ(atomic.load().get(), nullptr);
+  EXPECT_TRUE(atomic.is_lock_free());
+}
+
+// Test store and load
+TEST(AtomicSharedPtrTest, StoreAndLoad)
+{
+  auto sp = steev::make_shared<int>(7);
+  {
+    steev::atomic_shared_ptr<int> atomic(sp);
+    steev::shared_ptr<int> loaded = atomic.load();
+    EXPECT_EQ(loaded, sp);
+    EXPECT_EQ(*loaded, 7);
+
+    atomic.store(steev::make_shared<int>(8));
+    EXPECT_EQ(*atomic.load(), 8);
+    EXPECT_EQ(sp.use_count(), 2);
+  }
+  EXPECT_EQ(sp.use_count(), 1);
+}
+
+// Test exchange hands back the previous value
+TEST(AtomicSharedPtrTest, Exchange)
+{
+  steev::atomic_shared_ptr<int> atomic(steev::make_shared<int>(1));
+  steev::shared_ptr<int> old = atomic.exchange(steev::make_shared<int>(2));
+  EXPECT_EQ(*old, 1);
+  EXPECT_EQ(old.use_count(), 1);
+  EXPECT_EQ(*atomic.load(), 2);
+
+  old = atomic.exchange(steev::shared_ptr<int>());
+  EXPECT_EQ(*old, 2);
+  EXPECT_EQ(atomic.load().get(), nullptr);
+}
+
+// Test compare_exchange on success and on failure
+TEST(AtomicSharedPtrTest, CompareExchange)
+{
+  auto first = steev::make_shared<int>(1);
+  auto second = steev::make_shared<int>(2);
+  steev::atomic_shared_ptr<int> atomic(first);
+
+  steev::shared_ptr<int> expected = second;
+  EXPECT_FALSE(atomic.compare_exchange_strong(expected, second));
+  EXPECT_EQ(expected, first);
+
+  EXPECT_TRUE(atomic.compare_exchange_strong(expected, second));
+  EXPECT_EQ(atomic.load(), second);
+  EXPECT_EQ(first.use_count(), 2);
+
+  expected = steev::shared_ptr<int>();
+  EXPECT_FALSE(atomic.compare_exchange_weak(expected, first));
+  EXPECT_EQ(expected, second);
+}
+
+// Test many outstanding loads, enough to use up the prepaid references
+TEST(AtomicSharedPtrTest, ManyLoads)
+{
+  {
+    steev::atomic_shared_ptr<Counted> atomic(
+        steev::make_shared<Counted>(3));
+    std::vector<steev::shared_ptr<Counted>> loaded;
+    for (int i = 0; i < 20000; i++) {
+      loaded.push_back(atomic.load());
+    }
+    atomic.store(steev::shared_ptr<Counted>());
+    EXPECT_EQ(loaded.front().use_count(), 20000);
+    EXPECT_EQ(Counted::alive, 1);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+// Test readers racing writers that replace the value
+TEST(AtomicSharedPtrTest, ConcurrentLoadAndStore)
+{
+  {
+    steev::atomic_shared_ptr<Counted> atomic(
+        steev::make_shared<Counted>(0));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+      threads.emplace_back(
+          [&atomic, t]
+          {
+            for (int i = 0; i < 5000; i++) {
+              if (t == 0) {
+                atomic.store(steev::make_shared<Counted>(i));
+              } else {
+                steev::shared_ptr<Counted> loaded = atomic.load();
+                EXPECT_GE(loaded->value, 0);
+              }
+            }
+          });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+// Test compare_exchange as an increment loop
+TEST(AtomicSharedPtrTest, ConcurrentCompareExchange)
+{
+  steev::atomic_shared_ptr<int> atomic(steev::make_shared<int>(0));
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back(
+        [&atomic]
+        {
+          for (int i = 0; i < 1000; i++) {
+            steev::shared_ptr<int> expected = atomic.load();
+            while (!atomic.compare_exchange_weak(
+                expected, steev::make_shared<int>(*expected + 1)))
+            {
+            }
+          }
+        });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(*atomic.load(), 4000);
+}
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "memory/smart_ptr/control_block_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include "memory/smart_ptr/shared_ptr.hpp"
+
+TEST(ControlBlockPoolTest, SlotsAreAligned)
+{
+  void* slot = steev::control_block_pool::allocate();
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(slot)
+                % steev::control_block_pool::slot_alignment,
+            0);
+  steev::control_block_pool::deallocate(slot);
+}
+
+TEST(ControlBlockPoolTest, ReusesFreedSlots)
+{
+  void* first = steev::control_block_pool::allocate();
+  steev::control_block_pool::deallocate(first);
+  void* second = steev::control_block_pool::allocate();
+  EXPECT_EQ(first, second);
+  steev::control_block_pool::deallocate(second);
+}
+
+TEST(ControlBlockPoolTest, DistinctSlots)
+{
+  std::vector<void*> slots;
+  for (std::size_t i = 0; i < 3 * steev::control_block_pool::slab_slots; i++)
+  {
+    slots.push_back(steev::control_block_pool::allocate());
+  }
+  std::vector<void*> sorted = slots;
+  std::sort(sorted.begin(), sorted.end());
+  EXPECT_EQ(std::adjacent_find(sorted.begin(), sorted.end()), sorted.end());
+  for (void* slot : slots) {
+    steev::control_block_pool::deallocate(slot);
+  }
+}
+
+TEST(ControlBlockPoolTest, SharedPtrBlocksComeFromPool)
+{
+  void* slot = steev::control_block_pool::allocate();
+  steev::control_block_pool::deallocate(slot);
+
+  // The slot just returned is the next one handed out on this thread
+  steev::shared_ptr<int> sp(new int(1));
+  EXPECT_EQ(sp.use_count(), 1);
+  sp.reset();
+
+  void* again = steev::control_block_pool::allocate();
+  EXPECT_EQ(again, slot);
+  steev::control_block_pool::deallocate(again);
+}
+
+TEST(ControlBlockPoolTest, FreedOnAnotherThread)
+{
+  constexpr int count = 10000;
+  std::vector<steev::shared_ptr<int>> owners;
+  owners.reserve(count);
+  for (int i = 0; i < count; i++) {
+    owners.emplace_back(new int(i));
+  }
+
+  std::thread consumer([&owners] { owners.clear(); });
+  consumer.join();
+  EXPECT_TRUE(owners.empty());
+}
+
+TEST(ControlBlockPoolTest, ConcurrentChurn)
+{
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back(
+        []
+        {
+          std::vector<steev::shared_ptr<int>> owners;
+          for (int round = 0; round < 20; round++) {
+            for (int i = 0; i < 500; i++) {
+              owners.emplace_back(new int(i));
+            }
+            owners.clear();
+          }
+        });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
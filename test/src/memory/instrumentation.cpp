@@ -0,0 +1,123 @@
+#include <sstream>
+#include <string>
+
+#include "memory/instrumentation.hpp"
+
+#include <gtest/gtest.h>
+
+#include "containers/small_vector.hpp"
+#include "containers/vector.hpp"
+#include "memory/smart_ptr/shared_ptr.hpp"
+#include "memory/smart_ptr/unique_ptr.hpp"
+
+// Built into stdlib_instrumented_test, with STEEV_INSTRUMENT_ALLOCATIONS on
+
+namespace
+{
+struct Widget
+{
+  int value = 0;
+};
+}  // namespace
+
+static_assert(steev::instrumentation::enabled);
+
+// Test that vector growth shows up as reallocations
+TEST(InstrumentationTest, VectorGrowth)
+{
+  using widgets = steev::vector<Widget>;
+  steev::instrumentation::reset();
+  {
+    widgets vector;
+    for (int i = 0; i < 64; i++) {
+      vector.push_back(Widget {i});
+    }
+  }
+
+  auto counts = steev::instrumentation::counters_for<widgets>();
+  EXPECT_GT(counts.reallocations, 0U);
+  EXPECT_GT(counts.allocations, 0U);
+  EXPECT_EQ(counts.allocations, counts.deallocations);
+  EXPECT_GE(counts.bytes_allocated, 64 * sizeof(Widget));
+}
+
+// Test that small_vector only reports once it spills to the heap
+TEST(InstrumentationTest, SmallVectorSpill)
+{
+  using widgets = steev::small_vector<Widget, 4>;
+  steev::instrumentation::reset();
+  {
+    widgets vector;
+    for (int i = 0; i < 4; i++) {
+      vector.push_back(Widget {i});
+    }
+    EXPECT_EQ(steev::instrumentation::counters_for<widgets>().allocations, 0U);
+    vector.push_back(Widget {4});
+  }
+
+  auto counts = steev::instrumentation::counters_for<widgets>();
+  EXPECT_EQ(counts.allocations, 1U);
+  EXPECT_EQ(counts.deallocations, 1U);
+  EXPECT_EQ(counts.reallocations, 1U);
+}
+
+// Test the control blocks behind make_shared and raw-pointer adoption
+TEST(InstrumentationTest, ControlBlocks)
+{
+  steev::instrumentation::reset();
+  {
+    auto made = steev::make_shared<Widget>();
+    steev::shared_ptr<Widget> adopted(new Widget);
+  }
+
+  uint64_t allocations = 0;
+  uint64_t deallocations = 0;
+  for (const auto& entry : steev::instrumentation::snapshot()) {
+    if (entry.type.find("control_block<Widget") != std::string::npos
+        || entry.type.find("control_block<{anonymous}::Widget")
+            != std::string::npos
+        || entry.type.find("control_block<(anonymous namespace)::Widget")
+            != std::string::npos)
+    {
+      allocations += entry.counts.allocations;
+      deallocations += entry.counts.deallocations;
+    }
+  }
+  EXPECT_EQ(allocations, 2U);
+  EXPECT_EQ(deallocations, 2U);
+}
+
+// Test that make_unique is counted under its allocation-only site
+TEST(InstrumentationTest, MakeUnique)
+{
+  using site = steev::instrumentation::allocation_only<
+      steev::unique_ptr<Widget>>;
+  steev::instrumentation::reset();
+  {
+    auto widget = steev::make_unique<Widget>();
+  }
+  auto counts = steev::instrumentation::counters_for<site>();
+  EXPECT_EQ(counts.allocations, 1U);
+  EXPECT_EQ(counts.bytes_allocated, sizeof(Widget));
+
+  std::ostringstream out;
+  steev::instrumentation::dump(out);
+  EXPECT_NE(out.str().find("unique_ptr"), std::string::npos);
+  EXPECT_NE(out.str().find("(deallocations not tracked)"), std::string::npos);
+}
+
+// Test the text dump
+TEST(InstrumentationTest, Dump)
+{
+  steev::instrumentation::reset();
+  {
+    steev::vector<Widget> widgets;
+    widgets.push_back(Widget {});
+  }
+
+  std::ostringstream out;
+  steev::instrumentation::dump(out);
+  EXPECT_NE(out.str().find("vector"), std::string::npos);
+  EXPECT_NE(out.str().find("1 allocations, 1 deallocations"),
+            std::string::npos);
+}
@@ -0,0 +1,143 @@
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "memory/smart_ptr/intrusive_ptr.hpp"
+
+#include <gtest/gtest.h>
+
+#include "memory/relocate.hpp"
+
+namespace
+{
+struct Message : steev::intrusive_ref_counter<Message>
+{
+  static inline int alive = 0;
+
+  int id;
+
+  explicit Message(int i)
+      : id(i)
+  {
+    alive++;
+  }
+
+  Message(const Message& other)
+      : steev::intrusive_ref_counter<Message>(other)
+      , id(other.id)
+  {
+    alive++;
+  }
+
+  ~Message() { alive--; }
+};
+
+struct LocalMessage
+    : steev::intrusive_ref_counter<LocalMessage, steev::thread_unsafe_counter>
+{
+  int id = 0;
+};
+}  // namespace
+
+// Handles are one pointer wide
+static_assert(sizeof(steev::intrusive_ptr<Message>) == sizeof(Message*));
+static_assert(steev::is_trivially_relocatable_v<steev::intrusive_ptr<Message>>);
+
+// Test construction, copies and release
+TEST(IntrusivePtrTest, CopyAndRelease)
+{
+  {
+    steev::intrusive_ptr<Message> p1 = steev::make_intrusive<Message>(1);
+    EXPECT_EQ(p1->id, 1);
+    EXPECT_EQ(p1->use_count(), 1);
+
+    steev::intrusive_ptr<Message> p2 = p1;
+    EXPECT_EQ(p1, p2);
+    EXPECT_EQ(p1->use_count(), 2);
+
+    steev::intrusive_ptr<Message> p3 = std::move(p2);
+    EXPECT_FALSE(p2);
+    EXPECT_EQ(p3->use_count(), 2);
+
+    p1.reset();
+    EXPECT_EQ(p3->use_count(), 1);
+    EXPECT_EQ(Message::alive, 1);
+  }
+  EXPECT_EQ(Message::alive, 0);
+}
+
+// Test adopting and detaching a reference
+TEST(IntrusivePtrTest, AdoptAndDetach)
+{
+  steev::intrusive_ptr<Message> p1(new Message(2));
+  Message* raw = p1.detach();
+  EXPECT_FALSE(p1);
+  EXPECT_EQ(raw->use_count(), 1);
+
+  steev::intrusive_ptr<Message> p2(raw, false);
+  EXPECT_EQ(p2->use_count(), 1);
+  p2.reset();
+  EXPECT_EQ(Message::alive, 0);
+}
+
+// Test that copying the object does not copy its count
+TEST(IntrusivePtrTest, CopiedObjectStartsFresh)
+{
+  auto p1 = steev::make_intrusive<Message>(3);
+  auto p2 = p1;
+  steev::intrusive_ptr<Message> copy = steev::make_intrusive<Message>(*p1);
+  EXPECT_EQ(copy->id, 3);
+  EXPECT_EQ(copy->use_count(), 1);
+  EXPECT_EQ(p1->use_count(), 2);
+}
+
+// Test assignment from raw pointers and self assignment
+TEST(IntrusivePtrTest, Assignment)
+{
+  steev::intrusive_ptr<Message> p1;
+  p1 = new Message(4);
+  EXPECT_EQ(p1->use_count(), 1);
+
+  auto& alias = p1;
+  p1 = alias;
+  EXPECT_EQ(p1->use_count(), 1);
+
+  p1 = steev::make_intrusive<Message>(5);
+  EXPECT_EQ(p1->id, 5);
+  EXPECT_EQ(Message::alive, 1);
+}
+
+// Test the thread-unsafe counter
+TEST(IntrusivePtrTest, LocalCounter)
+{
+  auto p1 = steev::make_intrusive<LocalMessage>();
+  {
+    auto p2 = p1;
+    EXPECT_EQ(p1->use_count(), 2);
+  }
+  EXPECT_EQ(p1->use_count(), 1);
+}
+
+// Test copies from several threads
+TEST(IntrusivePtrTest, ConcurrentCopies)
+{
+  {
+    auto p = steev::make_intrusive<Message>(6);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+      threads.emplace_back(
+          [p]
+          {
+            for (int i = 0; i < 10000; i++) {
+              steev::intrusive_ptr<Message> copy = p;
+              EXPECT_EQ(copy->id, 6);
+            }
+          });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    EXPECT_EQ(p->use_count(), 1);
+  }
+  EXPECT_EQ(Message::alive, 0);
+}
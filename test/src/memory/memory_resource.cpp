@@ -0,0 +1,274 @@
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "memory/memory_resource.hpp"
+
+#include <gtest/gtest.h>
+
+#include "containers/vector.hpp"
+#include "memory/monotonic_buffer_resource.hpp"
+#include "memory/pool_resource.hpp"
+#include "memory/smart_ptr/shared_ptr.hpp"
+
+namespace
+{
+// Forwards to new_delete_resource() and keeps track of what is outstanding
+class CountingResource : public steev::memory_resource
+{
+public:
+  int allocations = 0;
+  int outstanding = 0;
+
+protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    allocations++;
+    outstanding++;
+    return steev::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* ptr,
+                     std::size_t bytes,
+                     std::size_t alignment) noexcept override
+  {
+    outstanding--;
+    steev::new_delete_resource()->deallocate(ptr, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+
+bool aligned(void* ptr, std::size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+}  // namespace
+
+// Test the global resources
+TEST(MemoryResourceTest, GlobalResources)
+{
+  steev::memory_resource* heap = steev::new_delete_resource();
+  EXPECT_EQ(steev::get_default_resource(), heap);
+  EXPECT_TRUE(*heap == *steev::new_delete_resource());
+  EXPECT_FALSE(*heap == *steev::null_memory_resource());
+
+  void* ptr = heap->allocate(64, 64);
+  EXPECT_TRUE(aligned(ptr, 64));
+  heap->deallocate(ptr, 64, 64);
+
+  EXPECT_THROW(
+      static_cast<void>(steev::null_memory_resource()->allocate(8)),
+      std::bad_alloc);
+
+  CountingResource counting;
+  EXPECT_EQ(steev::set_default_resource(&counting), heap);
+  EXPECT_EQ(steev::get_default_resource(), &counting);
+  EXPECT_EQ(steev::set_default_resource(nullptr), &counting);
+  EXPECT_EQ(steev::get_default_resource(), heap);
+}
+
+// Test that the arena bumps through the caller's buffer first
+TEST(MonotonicBufferResourceTest, UsesInitialBuffer)
+{
+  alignas(std::max_align_t) unsigned char buffer[256];
+  steev::monotonic_buffer_resource arena(
+      buffer, sizeof(buffer), steev::null_memory_resource());
+
+  void* first = arena.allocate(10, 1);
+  void* second = arena.allocate(16, 16);
+  EXPECT_EQ(first, buffer);
+  EXPECT_TRUE(aligned(second, 16));
+  EXPECT_GE(static_cast<unsigned char*>(second), buffer + 10);
+
+  EXPECT_THROW(static_cast<void>(arena.allocate(512)), std::bad_alloc);
+
+  arena.release();
+  EXPECT_EQ(arena.allocate(10, 1), buffer);
+}
+
+// Test growth into upstream chunks and release
+TEST(MonotonicBufferResourceTest, GrowsAndReleases)
+{
+  CountingResource upstream;
+  {
+    steev::monotonic_buffer_resource arena(128, &upstream);
+    for (int i = 0; i < 100; i++) {
+      void* ptr = arena.allocate(24, 8);
+      EXPECT_TRUE(aligned(ptr, 8));
+      arena.deallocate(ptr, 24, 8);
+    }
+    void* big = arena.allocate(10000, 256);
+    EXPECT_TRUE(aligned(big, 256));
+
+    EXPECT_GT(upstream.allocations, 1);
+    EXPECT_LT(upstream.allocations, 10);
+    arena.release();
+    EXPECT_EQ(upstream.outstanding, 0);
+
+    static_cast<void>(arena.allocate(8));
+  }
+  EXPECT_EQ(upstream.outstanding, 0);
+}
+
+// Test that a size the chunk header would wrap around is refused
+TEST(MonotonicBufferResourceTest, RejectsOverflowingSize)
+{
+  CountingResource upstream;
+  steev::monotonic_buffer_resource arena(&upstream);
+  EXPECT_THROW(static_cast<void>(arena.allocate(
+                   std::numeric_limits<std::size_t>::max() - 8, 64)),
+               std::bad_alloc);
+  EXPECT_EQ(upstream.allocations, 0);
+}
+
+// Test that freed blocks are handed out again
+TEST(PoolResourceTest, ReusesBlocks)
+{
+  CountingResource upstream;
+  steev::unsynchronized_pool_resource pool(&upstream);
+
+  void* first = pool.allocate(24, 8);
+  pool.deallocate(first, 24, 8);
+  void* second = pool.allocate(30, 8);
+  EXPECT_EQ(first, second);
+  pool.deallocate(second, 30, 8);
+
+  std::vector<void*> blocks;
+  for (int i = 0; i < 1000; i++) {
+    blocks.push_back(pool.allocate(48, 16));
+    EXPECT_TRUE(aligned(blocks.back(), 16));
+  }
+  int chunks = upstream.allocations;
+  for (void* block : blocks) {
+    pool.deallocate(block, 48, 16);
+  }
+  for (int i = 0; i < 1000; i++) {
+    blocks[static_cast<std::size_t>(i)] = pool.allocate(48, 16);
+  }
+  EXPECT_EQ(upstream.allocations, chunks);
+
+  pool.release();
+  EXPECT_EQ(upstream.outstanding, 0);
+}
+
+// Test requests too big or too aligned for any pool
+TEST(PoolResourceTest, Oversized)
+{
+  CountingResource upstream;
+  {
+    steev::unsynchronized_pool_resource pool(
+        {.max_blocks_per_chunk = 32, .largest_required_pool_block = 256},
+        &upstream);
+    EXPECT_EQ(pool.options().largest_required_pool_block, 256U);
+
+    void* big = pool.allocate(1000, 8);
+    void* aligned_block = pool.allocate(8, 1024);
+    void* leaked = pool.allocate(5000, 64);
+    EXPECT_TRUE(aligned(aligned_block, 1024));
+    EXPECT_TRUE(aligned(leaked, 64));
+    EXPECT_EQ(upstream.outstanding, 3);
+
+    pool.deallocate(big, 1000, 8);
+    pool.deallocate(aligned_block, 8, 1024);
+    EXPECT_EQ(upstream.outstanding, 1);
+  }
+  EXPECT_EQ(upstream.outstanding, 0);
+}
+
+// Test that an oversized request the header would wrap around is refused
+TEST(PoolResourceTest, RejectsOverflowingSize)
+{
+  CountingResource upstream;
+  steev::unsynchronized_pool_resource pool(&upstream);
+  EXPECT_THROW(static_cast<void>(pool.allocate(
+                   std::numeric_limits<std::size_t>::max() - 8, 64)),
+               std::bad_alloc);
+  EXPECT_EQ(upstream.allocations, 0);
+}
+
+// Test the synchronized pool from several threads
+TEST(PoolResourceTest, SynchronizedAcrossThreads)
+{
+  steev::synchronized_pool_resource pool;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back(
+        [&pool, t]
+        {
+          std::vector<int*> values;
+          for (int i = 0; i < 1000; i++) {
+            auto* value =
+                static_cast<int*>(pool.allocate(sizeof(int), alignof(int)));
+            *value = t;
+            values.push_back(value);
+          }
+          for (int* value : values) {
+            EXPECT_EQ(*value, t);
+            pool.deallocate(value, sizeof(int), alignof(int));
+          }
+        });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Test steev::vector drawing from an arena
+TEST(PolymorphicAllocatorTest, VectorInArena)
+{
+  alignas(std::max_align_t) unsigned char buffer[4096];
+  steev::monotonic_buffer_resource arena(
+      buffer, sizeof(buffer), steev::null_memory_resource());
+
+  steev::vector<int, steev::polymorphic_allocator<int>> vector(&arena);
+  for (int i = 0; i < 100; i++) {
+    vector.push_back(int {i});
+  }
+  EXPECT_EQ(vector.get_allocator().resource(), &arena);
+  EXPECT_GE(reinterpret_cast<unsigned char*>(vector.data()), buffer);
+  EXPECT_LT(reinterpret_cast<unsigned char*>(vector.data()),
+            buffer + sizeof(buffer));
+
+  // Copies go back to the default resource
+  auto copy = vector;
+  EXPECT_EQ(copy.get_allocator().resource(), steev::get_default_resource());
+  EXPECT_EQ(copy, vector);
+}
+
+// Test allocate_shared placing the object and its counts in a pool
+TEST(PolymorphicAllocatorTest, AllocateShared)
+{
+  CountingResource upstream;
+  {
+    steev::unsynchronized_pool_resource pool(&upstream);
+    steev::polymorphic_allocator<int> alloc(&pool);
+    {
+      auto first = steev::allocate_shared<int>(alloc, 1);
+      auto second = steev::allocate_shared<int>(alloc, 2);
+      EXPECT_EQ(*first + *second, 3);
+      EXPECT_EQ(upstream.allocations, 1);
+    }
+    auto third = steev::allocate_shared<int>(alloc, 3);
+    EXPECT_EQ(upstream.allocations, 1);
+  }
+  EXPECT_EQ(upstream.outstanding, 0);
+}
+
+// Test allocator equality follows the resources
+TEST(PolymorphicAllocatorTest, Equality)
+{
+  steev::unsynchronized_pool_resource first;
+  steev::unsynchronized_pool_resource second;
+  steev::polymorphic_allocator<int> a(&first);
+  steev::polymorphic_allocator<long> b(&first);
+  steev::polymorphic_allocator<int> c(&second);
+  EXPECT_TRUE(a == b);
+  EXPECT_FALSE(a == c);
+}
@@ -0,0 +1,96 @@
+#include <string>
+
+#include "memory/relocate.hpp"
+
+#include <gtest/gtest.h>
+
+#include "memory/smart_ptr/shared_ptr.hpp"
+#include "memory/smart_ptr/unique_ptr.hpp"
+#include "memory/smart_ptr/weak_ptr.hpp"
+
+struct OptedIn
+{
+  int value;
+  OptedIn(int v)
+      : value(v)
+  {
+  }
+  OptedIn(OptedIn&& other) noexcept
+      : value(other.value)
+  {
+  }
+  ~OptedIn() {}
+};
+
+template<>
+struct steev::is_trivially_relocatable<OptedIn> : std::true_type
+{
+};
+
+struct SelfReferential
+{
+  SelfReferential* self = this;
+  SelfReferential() = default;
+  SelfReferential(SelfReferential&&) noexcept
+      : self(this)
+  {
+  }
+  ~SelfReferential() {}
+};
+
+TEST(RelocateTest, TrivialTypes)
+{
+  static_assert(steev::is_trivially_relocatable_v<int>);
+  static_assert(steev::is_trivially_relocatable_v<double*>);
+  static_assert(steev::is_trivially_relocatable_v<const int>);
+}
+
+TEST(RelocateTest, NonTrivialTypes)
+{
+  static_assert(!steev::is_trivially_relocatable_v<SelfReferential>);
+  static_assert(!steev::is_trivially_relocatable_v<std::string>);
+}
+
+TEST(RelocateTest, OptIn)
+{
+  static_assert(steev::is_trivially_relocatable_v<OptedIn>);
+}
+
+TEST(RelocateTest, SmartPointers)
+{
+  static_assert(steev::is_trivially_relocatable_v<steev::unique_ptr<int>>);
+  static_assert(steev::is_trivially_relocatable_v<steev::unique_ptr<int[]>>);
+  static_assert(steev::is_trivially_relocatable_v<steev::shared_ptr<int>>);
+  static_assert(steev::is_trivially_relocatable_v<steev::weak_ptr<int>>);
+}
+
+TEST(RelocateTest, UninitializedRelocateBitwise)
+{
+  alignas(steev::unique_ptr<int>) unsigned char source[2 * sizeof(
+      steev::unique_ptr<int>)];
+  alignas(steev::unique_ptr<int>) unsigned char dest[2 * sizeof(
+      steev::unique_ptr<int>)];
+  auto* first = reinterpret_cast<steev::unique_ptr<int>*>(source);
+  auto* out = reinterpret_cast<steev::unique_ptr<int>*>(dest);
+
+  std::construct_at(first, new int(1));
+  std::construct_at(first + 1, new int(2));
+  auto* last = steev::uninitialized_relocate(first, first + 2, out);
+
+  EXPECT_EQ(last, out + 2);
+  EXPECT_EQ(*out[0], 1);
+  EXPECT_EQ(*out[1], 2);
+  std::destroy(out, last);
+}
+
+TEST(RelocateTest, UninitializedRelocateByMove)
+{
+  alignas(SelfReferential) unsigned char source[sizeof(SelfReferential)];
+  alignas(SelfReferential) unsigned char dest[sizeof(SelfReferential)];
+  auto* first = std::construct_at(reinterpret_cast<SelfReferential*>(source));
+  auto* out = reinterpret_cast<SelfReferential*>(dest);
+
+  steev::uninitialized_relocate(first, first + 1, out);
+  EXPECT_EQ(out->self, out);
+  std::destroy_at(out);
+}
@@ -1,3 +1,7 @@
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 #include "memory/smart_ptr/shared_ptr.hpp"
 
 #include <gtest/gtest.h>
@@ -186,3 +190,158 @@ TEST(SharedPtrTest, NullSharedPtr)
   EXPECT_EQ(sp1.use_count(), 0);
   EXPECT_EQ(sp2.use_count(), 0);
 }
+
+// 21. Custom Deleter
+TEST(SharedPtrTest, CustomDeleter)
+{
+  int deleted = 0;
+  {
+    steev::shared_ptr<int> sp(new int(5),
+                              [&deleted](int* ptr)
+                              {
+                                deleted++;
+                                delete ptr;
+                              });
+    auto copy = sp;
+    EXPECT_EQ(*copy, 5);
+  }
+  EXPECT_EQ(deleted, 1);
+}
+
+// 22. Single Allocation
+struct BlockStats
+{
+  int allocations = 0;
+  int deallocations = 0;
+};
+
+template<typename T>
+struct CountingAllocator
+{
+  using value_type = T;
+
+  BlockStats* stats;
+
+  explicit CountingAllocator(BlockStats* s)
+      : stats(s)
+  {
+  }
+
+  template<typename U>
+  CountingAllocator(const CountingAllocator<U>& other)
+      : stats(other.stats)
+  {
+  }
+
+  T* allocate(std::size_t count)
+  {
+    stats->allocations++;
+    return static_cast<T*>(::operator new(count * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t)
+  {
+    stats->deallocations++;
+    ::operator delete(ptr);
+  }
+};
+
+struct Tracked
+{
+  static inline int alive = 0;
+  int a;
+  int b;
+
+  Tracked(int x, int y)
+      : a(x)
+      , b(y)
+  {
+    alive++;
+  }
+  ~Tracked() { alive--; }
+};
+
+TEST(SharedPtrTest, AllocateSharedSingleAllocation)
+{
+  BlockStats stats;
+  {
+    auto sp = steev::allocate_shared<Tracked>(
+        CountingAllocator<Tracked>(&stats), 1, 2);
+    EXPECT_EQ(stats.allocations, 1);
+    EXPECT_EQ(sp->a, 1);
+    EXPECT_EQ(sp->b, 2);
+    EXPECT_EQ(Tracked::alive, 1);
+    auto copy = sp;
+    EXPECT_EQ(copy.use_count(), 2);
+  }
+  EXPECT_EQ(Tracked::alive, 0);
+  EXPECT_EQ(stats.deallocations, 1);
+}
+
+TEST(SharedPtrTest, MakeSharedMultipleArguments)
+{
+  auto sp = steev::make_shared<Tracked>(3, 4);
+  EXPECT_EQ(sp->a, 3);
+  EXPECT_EQ(sp->b, 4);
+  sp.reset();
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+// 23. Thread-local Counting
+TEST(LocalSharedPtrTest, CopiesShareCount)
+{
+  steev::local_shared_ptr<int> sp(new int(5));
+  auto copy = sp;
+  EXPECT_EQ(sp.use_count(), 2);
+  EXPECT_EQ(*copy, 5);
+  copy.reset();
+  EXPECT_EQ(sp.use_count(), 1);
+}
+
+TEST(LocalSharedPtrTest, MakeLocalShared)
+{
+  BlockStats stats;
+  {
+    auto sp = steev::allocate_local_shared<Tracked>(
+        CountingAllocator<Tracked>(&stats), 5, 6);
+    EXPECT_EQ(stats.allocations, 1);
+    EXPECT_EQ(sp->b, 6);
+  }
+  EXPECT_EQ(Tracked::alive, 0);
+  EXPECT_EQ(stats.deallocations, 1);
+
+  auto local = steev::make_local_shared<int>(9);
+  EXPECT_EQ(*local, 9);
+  EXPECT_EQ(local.use_count(), 1);
+}
+
+TEST(LocalSharedPtrTest, DistinctFromSharedPtr)
+{
+  static_assert(!std::is_same_v<steev::local_shared_ptr<int>,
+                                steev::shared_ptr<int>>);
+  static_assert(steev::is_trivially_relocatable_v<
+                steev::local_shared_ptr<int>>);
+}
+
+// 24. Concurrent Copies
+TEST(SharedPtrTest, ConcurrentCopies)
+{
+  auto sp = steev::make_shared<Tracked>(1, 2);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back(
+        [sp]
+        {
+          for (int i = 0; i < 10000; i++) {
+            steev::shared_ptr<Tracked> copy = sp;
+            EXPECT_EQ(copy->a, 1);
+          }
+        });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(sp.use_count(), 1);
+  sp.reset();
+  EXPECT_EQ(Tracked::alive, 0);
+}
@@ -1,3 +1,6 @@
+#include <atomic>
+#include <thread>
+
 #include "memory/smart_ptr/weak_ptr.hpp"
 
 #include <gtest/gtest.h>
@@ -100,3 +103,84 @@ TEST(WeakPtrTest, Swap)
   EXPECT_EQ(wp1.lock(), sp2);
   EXPECT_EQ(wp2.lock(), sp1);
 }
+
+// Test the inline block outliving its object
+struct Counted
+{
+  static inline int alive = 0;
+  Counted() { alive++; }
+  ~Counted() { alive--; }
+};
+
+TEST(WeakPtrTest, KeepsMakeSharedBlockAlive)
+{
+  steev::weak_ptr<Counted> wp(steev::make_shared<Counted>());
+  EXPECT_EQ(Counted::alive, 0);
+  EXPECT_TRUE(wp.expired());
+
+  auto sp = steev::make_shared<Counted>();
+  steev::weak_ptr<Counted> wp2(sp);
+  EXPECT_EQ(Counted::alive, 1);
+  sp.reset();
+  EXPECT_EQ(Counted::alive, 0);
+  EXPECT_TRUE(wp2.expired());
+  EXPECT_THROW(wp2.lock(), steev::bad_weak_ptr);
+}
+
+// Test the thread-local variant
+TEST(LocalWeakPtrTest, LockAndExpire)
+{
+  auto sp = steev::make_local_shared<int>(3);
+  steev::local_weak_ptr<int> wp(sp);
+  EXPECT_EQ(wp.use_count(), 1);
+
+  auto locked = wp.lock();
+  EXPECT_EQ(*locked, 3);
+  EXPECT_EQ(sp.use_count(), 2);
+
+  sp.reset();
+  locked.reset();
+  EXPECT_TRUE(wp.expired());
+  EXPECT_THROW(wp.lock(), steev::bad_weak_ptr);
+}
+
+// Test weak counts alongside strong ones
+TEST(WeakPtrTest, WeakCount)
+{
+  steev::shared_ptr<int> sp(new int(1));
+  steev::weak_ptr<int> wp1(sp);
+  steev::weak_ptr<int> wp2(wp1);
+  EXPECT_EQ(sp.use_count(), 1);
+
+  sp.reset();
+  EXPECT_TRUE(wp1.expired());
+  wp1.reset();
+  EXPECT_TRUE(wp2.expired());
+}
+
+// Test lock racing the last owner
+TEST(WeakPtrTest, ConcurrentLockAndRelease)
+{
+  for (int round = 0; round < 200; round++) {
+    auto sp = steev::make_shared<int>(round);
+    steev::weak_ptr<int> wp(sp);
+    std::atomic<int> locked {0};
+
+    std::thread reader(
+        [&wp, &locked, round]
+        {
+          for (int i = 0; i < 100; i++) {
+            try {
+              auto held = wp.lock();
+              EXPECT_EQ(*held, round);
+              locked++;
+            } catch (const steev::bad_weak_ptr&) {
+              break;
+            }
+          }
+        });
+    sp.reset();
+    reader.join();
+    EXPECT_TRUE(wp.expired());
+  }
+}